@@ -21,6 +21,7 @@ class configuration {
 inline void configuration::standard( MatchConfig & config ) {
         config.filename                        = "";
         config.seed                            = 0;
+        config.rng_engine                      = DEFAULT_RNG_ENGINE;
         config.post_blossom                    = false;
         config.algorithm                       = RANDOM_WALK;
         config.rw_max_length                   = 10;
@@ -28,14 +29,31 @@ inline void configuration::standard( MatchConfig & config ) {
         config.rw_ending_additional_settle     = false;
         config.rw_low_degree_value             = 10000000;
         config.rw_repetitions_per_node         = 1;
+        config.rw_walk_group                   = 16;
         config.blossom_init                    = BLOSSOMEXTRAGREEDY;
+        config.static_engine                   = STATIC_EDMONDS;
+        config.threads                         = 1;
+        config.batch_size                      = 1;
         config.naive_settle_on_insertion       = false;
+        config.free_neighbor_counts            = false;
         config.fast_rw                         = false;
         config.measure_graph_construction_only = false;
         config.dynblossom_speedheuristic       = false;
         config.dynblossom_weakspeedheuristic   = false;
         config.maintain_opt                    = false;
+        config.dynblossom_reuse_forest         = false;
+        config.dynblossom_local_budget         = 4096;
+        config.dynblossom_repair_budget        = 0;
+        config.dynblossom_repair_edges         = 256;
+        config.dynblossom_lazy_drain           = false;
         config.bgs_factor                      = 1;
+        config.bulk_load                       = false;
+        config.bulk_load_prefix                = 0;
+        config.bipartite_detection             = true;
+        config.sides_filename                  = "";
+        config.checkpoint_filename             = "";
+        config.checkpoint_every                = 0;
+        config.restore_filename                = "";
 }
 
 #endif /* end of include guard: CONFIGURATION_3APG5V7Z */
@@ -4,6 +4,12 @@
 #include "blossom_dyn_matching.h"
 #include "blossom_dyn_matching_naive.h"
 #include "static_blossom.h"
+#include "phase_blossom.h"
+#include "parallel_blossom.h"
+#include "bipartite_dyn_matching.h"
+#include "hopcroft_karp.h"
+#include "tools/bipartition.h"
+#include "io/checkpoint_io.h"
 #include "io/graph_io.h"
 #include "rw_dyn_matching.h"
 #include "baswanaguptasen_dyn_matching.h"
@@ -37,6 +43,7 @@ int main (int argn, char ** argv) {
 
         // initialize seed
         srand(match_config.seed);
+        random_functions::setEngine(match_config.rng_engine);
         random_functions::setSeed(match_config.seed);
 
         dyn_graph_access * G = new dyn_graph_access(n);
@@ -58,37 +65,79 @@ int main (int argn, char ** argv) {
                 exit(0);
         }
 
-        dyn_matching * algorithm = NULL;
+        // on bipartite graphs the blossom engines are replaced by ones without
+        // blossom bookkeeping
+        bool blossom_engine = match_config.algorithm == DYNBLOSSOM || match_config.algorithm == BLOSSOM || match_config.post_blossom;
+        if( !match_config.sides_filename.empty() ) {
+                if( !bipartition::read(match_config.sides_filename, G->number_of_nodes(), edge_sequence, match_config.sides) ) {
+                        delete G;
+                        exit(1);
+                }
+        } else if( blossom_engine && match_config.bipartite_detection ) {
+                timer tdetect; tdetect._restart();
+                if( bipartition::detect(G->number_of_nodes(), edge_sequence, match_config.sides) ) {
+                        std::cout <<  "graph is bipartite, detection took " <<  tdetect._elapsed()  << std::endl;
+                }
+        }
+        if( !match_config.sides.empty() ) {
+                if( match_config.algorithm == DYNBLOSSOM ) {
+                        match_config.algorithm = DYNBIPARTITE;
+                        std::cout <<  "running bipartite dynamic algorithm"  << std::endl;
+                } else if( match_config.algorithm == BLOSSOM ) {
+                        match_config.algorithm = HOPCROFTKARP;
+                        std::cout <<  "running hopcroft karp after making all updates"  << std::endl;
+                }
+        }
+
+        // the algorithm is selected at runtime, the driver is specialized on it
         switch( match_config.algorithm ) {
-                case RANDOM_WALK:
-                        algorithm = new rw_dyn_matching(G, match_config);
-                        break;
-                case BASWANA_GUPTA_SENG:
-                        algorithm = new baswanaguptasen_dyn_matching(G, match_config);
-                        break;
-                case NEIMAN_SOLOMON:
-                        algorithm = new neimansolomon_dyn_matching(G, match_config);
-                        break;
-                case NAIVE: 
-                        algorithm = new naive_dyn_matching(G, match_config);
-                        break;
-                case DYNBLOSSOM:
-                        algorithm = new blossom_dyn_matching(G, match_config);
-                        break;
-                case DYNBLOSSOMNAIVE:
-                        algorithm = new blossom_dyn_matching_naive(G, match_config);
-                        break;
+                case RANDOM_WALK: {
+                        rw_dyn_matching algorithm(G, match_config);
+                        run_dynamic_algorithm(G, edge_sequence, &algorithm, match_config);
+                        } break;
+                case BASWANA_GUPTA_SENG: {
+                        baswanaguptasen_dyn_matching algorithm(G, match_config);
+                        run_dynamic_algorithm(G, edge_sequence, &algorithm, match_config);
+                        } break;
+                case NEIMAN_SOLOMON: {
+                        neimansolomon_dyn_matching algorithm(G, match_config);
+                        run_dynamic_algorithm(G, edge_sequence, &algorithm, match_config);
+                        } break;
+                case NAIVE: {
+                        naive_dyn_matching algorithm(G, match_config);
+                        run_dynamic_algorithm(G, edge_sequence, &algorithm, match_config);
+                        } break;
+                case DYNBLOSSOM: {
+                        blossom_dyn_matching algorithm(G, match_config);
+                        run_dynamic_algorithm(G, edge_sequence, &algorithm, match_config);
+                        } break;
+                case DYNBLOSSOMNAIVE: {
+                        blossom_dyn_matching_naive algorithm(G, match_config);
+                        run_dynamic_algorithm(G, edge_sequence, &algorithm, match_config);
+                        } break;
+                case DYNBIPARTITE: {
+                        bipartite_dyn_matching algorithm(G, match_config);
+                        run_dynamic_algorithm(G, edge_sequence, &algorithm, match_config);
+                        } break;
+                case HOPCROFTKARP: {
+                        hopcroft_karp algorithm(G, match_config);
+                        run_dynamic_algorithm(G, edge_sequence, &algorithm, match_config);
+                        } break;
                 case BLOSSOM: 
-                        algorithm = new static_blossom(G, match_config);
+                        if( match_config.static_engine == STATIC_PHASES ) {
+                                phase_blossom algorithm(G, match_config);
+                                run_dynamic_algorithm(G, edge_sequence, &algorithm, match_config);
+                        } else if( match_config.static_engine == STATIC_PARALLEL ) {
+                                parallel_blossom algorithm(G, match_config);
+                                run_dynamic_algorithm(G, edge_sequence, &algorithm, match_config);
+                        } else {
+                                static_blossom algorithm(G, match_config);
+                                run_dynamic_algorithm(G, edge_sequence, &algorithm, match_config);
+                        } 
                         break;
-
         }
 
-        if(algorithm != NULL) 
-                run_dynamic_algorithm(G, edge_sequence, algorithm, match_config);
-
         delete G;
-        delete algorithm;
 
         return 0;
 }
@@ -0,0 +1,189 @@
+/******************************************************************************
+ * dynmatch_client.cpp
+ *
+ * Load generator for dynmatch_server. Replays a dynamic graph sequence in
+ * batches and issues mate queries between the batches.
+ *
+ *****************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <algorithm>
+#include <iostream>
+#include <vector>
+#include <argtable3.h>
+
+#include "definitions.h"
+#include "io/graph_io.h"
+#include "server_protocol.h"
+#include "tools/random_functions.h"
+#include "tools/timer.h"
+
+static bool request(int fd, uint32_t type, const void * payload, uint32_t count, size_t record_size,
+                    response_header & answer, void * answer_payload, size_t answer_record_size) {
+        request_header header;
+        header.type  = type;
+        header.count = count;
+        if( !write_fully(fd, &header, sizeof(header)) ) return false;
+        if( count > 0 && !write_fully(fd, payload, count * record_size) ) return false;
+        if( !read_fully(fd, &answer, sizeof(answer)) ) return false;
+        if( answer.status != STATUS_OK ) return false;
+
+        // updates are answered with the applied count and the matching size
+        size_t records = type == MSG_UPDATES ? 1 : answer.count;
+        if( records > 0 && answer_payload != NULL ) return read_fully(fd, answer_payload, records * answer_record_size);
+        return true;
+}
+
+int main(int argn, char **argv)
+{
+        const char *progname = argv[0];
+
+        // Setup argtable parameters.
+        struct arg_lit *help                        = arg_lit0(NULL, "help","Print help.");
+        struct arg_str *filename                    = arg_strn(NULL, NULL, "FILE", 1, 1, "Path to dynamic graph sequence to replay.");
+        struct arg_str *socket_path                 = arg_str0(NULL, "socket", NULL, "Path of the Unix domain socket (default /tmp/dynmatch.sock).");
+        struct arg_int *batch_size                  = arg_int0(NULL, "batch_size", NULL, "Updates per batch (default 1000).");
+        struct arg_int *queries                     = arg_int0(NULL, "queries_per_batch", NULL, "Mate queries sent after each batch (default 100).");
+        struct arg_int *user_seed                   = arg_int0(NULL, "seed", NULL, "Seed to use for choosing query nodes.");
+        struct arg_lit *shutdown                    = arg_lit0(NULL, "shutdown","Shut the server down when done.");
+        struct arg_lit *deltas                      = arg_lit0(NULL, "deltas","Drain the changes of the matching after each batch (server needs --deltas).");
+        struct arg_end *end                         = arg_end(100);
+
+        // Define argtable.
+        void* argtable[] = {
+                help, filename, socket_path, batch_size, queries, user_seed, shutdown, deltas, end
+        };
+        // Parse arguments.
+        int nerrors = arg_parse(argn, argv, argtable);
+
+        // Catch case that help was requested.
+        if (help->count > 0) {
+                printf("Usage: %s", progname);
+                arg_print_syntax(stdout, argtable, "\n");
+                arg_print_glossary(stdout, argtable,"  %-40s %s\n");
+                arg_freetable(argtable, sizeof(argtable) / sizeof(argtable[0]));
+                return 1;
+        }
+
+        if (nerrors > 0) {
+                arg_print_errors(stderr, end, progname);
+                printf("Try '%s --help' for more information.\n",progname);
+                arg_freetable(argtable, sizeof(argtable) / sizeof(argtable[0]));
+                return 1;
+        }
+
+        std::string graph_filename = filename->sval[0];
+        std::string path           = socket_path->count > 0 ? socket_path->sval[0] : "/tmp/dynmatch.sock";
+        uint32_t    batch          = batch_size->count > 0 ? std::max(1, batch_size->ival[0]) : 1000;
+        uint32_t    query_count    = queries->count > 0 ? std::max(0, queries->ival[0]) : 100;
+        bool        send_shutdown  = shutdown->count > 0;
+        bool        drain_deltas   = deltas->count > 0;
+        random_functions::setSeed(user_seed->count > 0 ? user_seed->ival[0] : 0);
+        arg_freetable(argtable, sizeof(argtable) / sizeof(argtable[0]));
+        batch = std::min(batch, MAX_RECORDS_PER_MESSAGE);
+        query_count = std::min(query_count, MAX_RECORDS_PER_MESSAGE);
+
+        graph_io gio;
+        std::vector<std::pair<int, std::pair<NodeID, NodeID> > > edge_sequence;
+        NodeID n = gio.read_sequence(graph_filename, edge_sequence);
+
+        int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+        sockaddr_un address;
+        memset(&address, 0, sizeof(address));
+        address.sun_family = AF_UNIX;
+        strncpy(address.sun_path, path.c_str(), sizeof(address.sun_path)-1);
+        if( fd < 0 || connect(fd, (sockaddr *) &address, sizeof(address)) < 0 ) {
+                perror("could not connect to server");
+                return 1;
+        }
+
+        std::vector< update_record > updates;
+        std::vector< uint32_t > nodes(query_count), mates(query_count);
+        std::vector< delta_record > changes;
+        response_header answer;
+        uint32_t matching_size = 0;
+        double update_time = 0, query_time = 0, delta_time = 0, max_update_latency = 0;
+        unsigned long long sent = 0, received_deltas = 0;
+
+        timer total; total._restart();
+        for( size_t start = 0; start < edge_sequence.size(); start += batch) {
+                size_t stop = std::min(edge_sequence.size(), start + batch);
+                updates.resize(stop - start);
+                for( size_t i = start; i < stop; i++) {
+                        updates[i-start].insert = edge_sequence[i].first;
+                        updates[i-start].u      = edge_sequence[i].second.first;
+                        updates[i-start].v      = edge_sequence[i].second.second;
+                }
+
+                timer t; t._restart();
+                if( !request(fd, MSG_UPDATES, updates.data(), updates.size(), sizeof(update_record), answer, &matching_size, sizeof(uint32_t)) ) {
+                        std::cerr << "update request failed" << std::endl;
+                        return 1;
+                }
+                double latency = t._elapsed();
+                update_time += latency;
+                max_update_latency = std::max(max_update_latency, latency);
+                sent += updates.size();
+
+                if( drain_deltas ) {
+                        // drained in chunks until the server has no more changes
+                        changes.resize(std::min((size_t) MAX_RECORDS_PER_MESSAGE, 4*updates.size() + 4));
+                        t._restart();
+                        do {
+                                if( !request(fd, MSG_DELTAS, NULL, changes.size(), 0, answer, changes.data(), sizeof(delta_record)) ) {
+                                        std::cerr << "delta request failed" << std::endl;
+                                        return 1;
+                                }
+                                received_deltas += answer.count;
+                        } while( answer.count == changes.size() );
+                        delta_time += t._elapsed();
+                }
+
+                if( query_count == 0 || n == 0 ) continue;
+                for( uint32_t i = 0; i < query_count; i++) {
+                        nodes[i] = random_functions::nextInt(0, n-1);
+                }
+                t._restart();
+                if( !request(fd, MSG_MATES, nodes.data(), query_count, sizeof(uint32_t), answer, mates.data(), sizeof(uint32_t)) ) {
+                        std::cerr << "query request failed" << std::endl;
+                        return 1;
+                }
+                query_time += t._elapsed();
+        }
+        double elapsed = total._elapsed();
+
+        server_stats stats;
+        if( !request(fd, MSG_STATS, NULL, 0, 0, answer, &stats, sizeof(stats)) ) {
+                std::cerr << "stats request failed" << std::endl;
+                return 1;
+        }
+        if( send_shutdown ) {
+                request(fd, MSG_SHUTDOWN, NULL, 0, 0, answer, NULL, 0);
+        }
+        close(fd);
+
+        size_t batches = (edge_sequence.size() + batch - 1) / batch;
+        std::cout << "client: " << sent << " updates in " << batches << " batches, "
+                  << sent / std::max(update_time, 1e-9) << " updates/s, "
+                  << "mean batch round trip " << update_time / std::max((size_t) 1, batches) << " s, "
+                  << "max " << max_update_latency << " s" << std::endl;
+        std::cout << "client: " << batches * query_count << " queries, "
+                  << (batches * query_count) / std::max(query_time, 1e-9) << " queries/s" << std::endl;
+        if( drain_deltas ) {
+                std::cout << "client: " << received_deltas << " matching changes received in " << delta_time << " s" << std::endl;
+        }
+        std::cout << "client: total " << elapsed << " s, matching size " << matching_size << std::endl;
+        std::cout << "server: " << stats.updates << " applied updates in " << stats.update_batches << " batches, "
+                  << stats.updates / std::max(stats.update_seconds, 1e-9) << " updates/s, "
+                  << "batch latency p50 " << stats.batch_latency_p50 << " s p99 " << stats.batch_latency_p99
+                  << " s max " << stats.batch_latency_max << " s" << std::endl;
+        std::cout << "server: " << stats.queries << " queries, "
+                  << stats.queries / std::max(stats.query_seconds, 1e-9) << " queries/s, matching size "
+                  << stats.matching_size << std::endl;
+
+        return 0;
+}
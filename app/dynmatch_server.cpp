@@ -0,0 +1,405 @@
+/******************************************************************************
+ * dynmatch_server.cpp
+ *
+ * Keeps a graph and a dynamic matching resident and serves batched updates
+ * and mate queries over a Unix domain socket, see server_protocol.h. The
+ * static engine is not served, its matching only exists after the final solve.
+ *
+ *****************************************************************************/
+
+#include <poll.h>
+#include <signal.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <algorithm>
+#include <iostream>
+#include <vector>
+#include <argtable3.h>
+#include <regex.h>
+
+#include "dynmatch_interface.h"
+#include "server_protocol.h"
+#include "tools/timer.h"
+
+static volatile sig_atomic_t stop_requested = 0;
+
+static void handle_signal(int) {
+        stop_requested = 1;
+}
+
+// latencies are kept in power of two buckets of microseconds, which is
+// enough to report percentiles of a long running server in constant space
+class latency_histogram {
+        public:
+                latency_histogram() : m_count(0), m_max(0) {
+                        for( int i = 0; i < BUCKETS; i++) m_buckets[i] = 0;
+                }
+
+                void add(double seconds) {
+                        uint64_t micros = (uint64_t) (seconds * 1e6);
+                        int bucket = 0;
+                        while( micros > 0 && bucket < BUCKETS-1 ) { micros >>= 1; bucket++; }
+                        m_buckets[bucket]++;
+                        m_count++;
+                        if( seconds > m_max ) m_max = seconds;
+                }
+
+                // upper end of the bucket that contains the given quantile
+                double quantile(double q) const {
+                        if( m_count == 0 ) return 0;
+                        uint64_t rank = (uint64_t) (q * m_count);
+                        uint64_t seen = 0;
+                        for( int i = 0; i < BUCKETS; i++) {
+                                seen += m_buckets[i];
+                                if( seen > rank ) return std::min(m_max, (double) (1ULL << i) / 1e6);
+                        }
+                        return m_max;
+                }
+
+                double max() const { return m_max; }
+
+        private:
+                static const int BUCKETS = 48;
+                uint64_t m_buckets[BUCKETS];
+                uint64_t m_count;
+                double   m_max;
+};
+
+struct server_state {
+        dynmatch_matcher * matcher;
+        server_stats       stats;
+        latency_histogram  batch_latency;
+
+        std::vector< dynmatch_update > updates;
+        std::vector< uint32_t >        nodes;
+        std::vector< uint32_t >        answer;
+        std::vector< dynmatch_delta >  deltas;
+};
+
+// a client is never waited for. its requests are buffered until they are
+// complete and its answers until it reads them, so a slow client or one that
+// does not read stalls nobody else
+struct connection {
+        int                 fd;
+        std::vector< char > pending;  // received bytes of incomplete requests
+        std::vector< char > outgoing; // answers, sent from outgoing_head on
+        size_t              outgoing_head;
+
+        connection() : fd(-1), outgoing_head(0) {}
+
+        // no more requests are handled until the client has read this much
+        static const size_t OUTGOING_LIMIT = 1 << 20;
+
+        bool backlogged() const {
+                return outgoing.size() - outgoing_head > OUTGOING_LIMIT;
+        }
+};
+
+static void enqueue(connection & client, const void * data, size_t bytes) {
+        const char * begin = (const char *) data;
+        client.outgoing.insert(client.outgoing.end(), begin, begin + bytes);
+}
+
+static void respond(connection & client, uint32_t status, const void * payload, uint32_t count, size_t record_size) {
+        response_header header;
+        header.status = status;
+        header.count  = count;
+        enqueue(client, &header, sizeof(header));
+        if( count > 0 ) enqueue(client, payload, count * record_size);
+}
+
+// sends as much of the queued answers as the socket takes, returns false on error
+static bool send_queued(connection & client) {
+        while( client.outgoing_head < client.outgoing.size() ) {
+                ssize_t w = send(client.fd, client.outgoing.data() + client.outgoing_head,
+                                 client.outgoing.size() - client.outgoing_head, MSG_DONTWAIT);
+                if( w < 0 && errno == EINTR ) continue;
+                if( w < 0 && (errno == EAGAIN || errno == EWOULDBLOCK) ) break;
+                if( w <= 0 ) return false;
+                client.outgoing_head += w;
+        }
+        // the sent prefix is dropped once it is the larger part, so appending
+        // and sending stay amortized O(1) per byte
+        if( client.outgoing_head * 2 >= client.outgoing.size() ) {
+                client.outgoing.erase(client.outgoing.begin(), client.outgoing.begin() + client.outgoing_head);
+                client.outgoing_head = 0;
+        }
+        return true;
+}
+
+// bytes of the records that follow the header of a request
+static size_t payload_bytes(const request_header & header) {
+        switch( header.type ) {
+                case MSG_UPDATES: return header.count * sizeof(update_record);
+                case MSG_MATES:   return header.count * sizeof(uint32_t);
+                default:          return 0;
+        }
+}
+
+// handles one complete request, returns false if the connection should be closed
+static bool handle_request(connection & client, const request_header & header, const char * payload, server_state & state, bool & shutdown) {
+        timer t;
+        switch( header.type ) {
+                case MSG_UPDATES: {
+                        state.updates.resize(header.count);
+                        memcpy(state.updates.data(), payload, payload_bytes(header));
+
+                        t._restart();
+                        long applied = dynmatch_apply_updates(state.matcher, state.updates.data(), header.count);
+                        double elapsed = t._elapsed();
+
+                        state.stats.updates        += applied;
+                        state.stats.update_batches += 1;
+                        state.stats.update_seconds += elapsed;
+                        state.batch_latency.add(elapsed);
+
+                        uint32_t size = dynmatch_matching_size(state.matcher);
+                        response_header answer;
+                        answer.status = STATUS_OK;
+                        answer.count  = applied;
+                        enqueue(client, &answer, sizeof(answer));
+                        enqueue(client, &size, sizeof(size));
+                        return true;
+                }
+                case MSG_MATES: {
+                        state.nodes.resize(header.count);
+                        state.answer.resize(header.count);
+                        memcpy(state.nodes.data(), payload, payload_bytes(header));
+
+                        t._restart();
+                        for( uint32_t i = 0; i < header.count; i++) {
+                                state.answer[i] = dynmatch_mate(state.matcher, state.nodes[i]);
+                        }
+                        state.stats.queries       += header.count;
+                        state.stats.query_batches += 1;
+                        state.stats.query_seconds += t._elapsed();
+
+                        respond(client, STATUS_OK, state.answer.data(), header.count, sizeof(uint32_t));
+                        return true;
+                }
+                case MSG_SIZE: {
+                        uint32_t size = dynmatch_matching_size(state.matcher);
+                        respond(client, STATUS_OK, &size, 1, sizeof(size));
+                        return true;
+                }
+                case MSG_STATS: {
+                        state.stats.matching_size     = dynmatch_matching_size(state.matcher);
+                        state.stats.batch_latency_p50 = state.batch_latency.quantile(0.5);
+                        state.stats.batch_latency_p99 = state.batch_latency.quantile(0.99);
+                        state.stats.batch_latency_max = state.batch_latency.max();
+                        respond(client, STATUS_OK, &state.stats, 1, sizeof(server_stats));
+                        return true;
+                }
+                case MSG_DELTAS: {
+                        state.deltas.resize(header.count);
+                        size_t count = dynmatch_drain_deltas(state.matcher, state.deltas.data(), header.count);
+                        respond(client, STATUS_OK, state.deltas.data(), count, sizeof(dynmatch_delta));
+                        return true;
+                }
+                case MSG_SHUTDOWN: {
+                        shutdown = true;
+                        respond(client, STATUS_OK, NULL, 0, 0);
+                        return false;
+                }
+                default:
+                        respond(client, STATUS_BAD_REQUEST, NULL, 0, 0);
+                        return false;
+        }
+}
+
+// reads what the client has sent so far without blocking, at most 16 chunks
+// so a client that keeps sending does not hold the loop. returns false on EOF
+// or error
+static bool receive(connection & client) {
+        char chunk[1 << 16];
+        for( int chunks = 0; chunks < 16; ) {
+                ssize_t r = recv(client.fd, chunk, sizeof(chunk), MSG_DONTWAIT);
+                if( r > 0 ) {
+                        client.pending.insert(client.pending.end(), chunk, chunk + r);
+                        chunks++;
+                        continue;
+                }
+                if( r < 0 && errno == EINTR ) continue;
+                return r < 0 && (errno == EAGAIN || errno == EWOULDBLOCK);
+        }
+        return true;
+}
+
+// handles the complete requests in the buffer of the client until its answers
+// back up, returns false if the connection should be closed
+static bool serve(connection & client, server_state & state, bool & shutdown) {
+        size_t done = 0;
+        bool   keep = true;
+        while( keep && !shutdown && !client.backlogged() && client.pending.size() - done >= sizeof(request_header) ) {
+                request_header header;
+                memcpy(&header, client.pending.data() + done, sizeof(header));
+                if( header.count > MAX_RECORDS_PER_MESSAGE ) {
+                        respond(client, STATUS_BAD_REQUEST, NULL, 0, 0);
+                        return false;
+                }
+
+                size_t bytes = sizeof(header) + payload_bytes(header);
+                if( client.pending.size() - done < bytes ) break;
+
+                keep  = handle_request(client, header, client.pending.data() + done + sizeof(header), state, shutdown);
+                done += bytes;
+        }
+        client.pending.erase(client.pending.begin(), client.pending.begin() + done);
+        return keep;
+}
+
+int main(int argn, char **argv)
+{
+        static_assert(sizeof(update_record) == sizeof(dynmatch_update), "update records are passed through unchanged");
+        static_assert(sizeof(delta_record) == sizeof(dynmatch_delta), "delta records are passed through unchanged");
+
+        const char *progname = argv[0];
+
+        // Setup argtable parameters.
+        struct arg_lit *help                        = arg_lit0(NULL, "help","Print help.");
+        struct arg_str *socket_path                 = arg_str0(NULL, "socket", NULL, "Path of the Unix domain socket (default /tmp/dynmatch.sock).");
+        struct arg_int *user_n                      = arg_int1(NULL, "n", NULL, "Number of nodes.");
+        struct arg_rex *algorithm_type              = arg_rex0(NULL, "algorithm", "^(dynblossom|naive|randomwalk|neimansolomon|baswanaguptasen)$", "TYPE", REG_EXTENDED, "Algorithm to use. One of {dynblossom, naive, randomwalk, neimansolomon, baswanaguptasen}");
+        struct arg_int *user_seed                   = arg_int0(NULL, "seed", NULL, "Seed to use for the PRNG.");
+        struct arg_dbl *eps                         = arg_dbl0(NULL, "eps", NULL, "Epsilon. Limit search depth of random walk or augmenting path search in dynblossom to 2/eps-1.");
+        struct arg_lit *dynblossom_speedheuristic   = arg_lit0(NULL, "dynblossom_lazy","Lazy approach for dynblossom.");
+        struct arg_lit *dynblossom_maintain_opt     = arg_lit0(NULL, "dynblossom_maintain_opt","Maintain optimum in dynblossom.");
+        struct arg_lit *deltas                      = arg_lit0(NULL, "deltas","Record the changes of the matching for MSG_DELTAS requests.");
+        struct arg_end *end                         = arg_end(100);
+
+        // Define argtable.
+        void* argtable[] = {
+                help, socket_path, user_n, algorithm_type, user_seed, eps, dynblossom_speedheuristic, dynblossom_maintain_opt, deltas, end
+        };
+        // Parse arguments.
+        int nerrors = arg_parse(argn, argv, argtable);
+
+        // Catch case that help was requested.
+        if (help->count > 0) {
+                printf("Usage: %s", progname);
+                arg_print_syntax(stdout, argtable, "\n");
+                arg_print_glossary(stdout, argtable,"  %-40s %s\n");
+                arg_freetable(argtable, sizeof(argtable) / sizeof(argtable[0]));
+                return 1;
+        }
+
+        if (nerrors > 0) {
+                arg_print_errors(stderr, end, progname);
+                printf("Try '%s --help' for more information.\n",progname);
+                arg_freetable(argtable, sizeof(argtable) / sizeof(argtable[0]));
+                return 1;
+        }
+
+        dynmatch_options options;
+        dynmatch_default_options(&options);
+        if( algorithm_type->count > 0 ) {
+                const char * name = algorithm_type->sval[0];
+                if(      strcmp("dynblossom",      name) == 0 ) options.algorithm = DYNMATCH_DYNBLOSSOM;
+                else if( strcmp("naive",           name) == 0 ) options.algorithm = DYNMATCH_NAIVE;
+                else if( strcmp("randomwalk",      name) == 0 ) options.algorithm = DYNMATCH_RANDOM_WALK;
+                else if( strcmp("neimansolomon",   name) == 0 ) options.algorithm = DYNMATCH_NEIMAN_SOLOMON;
+                else if( strcmp("baswanaguptasen", name) == 0 ) options.algorithm = DYNMATCH_BASWANA_GUPTA_SEN;
+        }
+        if( user_seed->count > 0 )                 options.seed = user_seed->ival[0];
+        if( eps->count > 0 )                       options.eps  = eps->dval[0];
+        if( dynblossom_speedheuristic->count > 0 ) options.lazy = 1;
+        if( dynblossom_maintain_opt->count > 0 )   options.maintain_opt = 1;
+
+        std::string path = socket_path->count > 0 ? socket_path->sval[0] : "/tmp/dynmatch.sock";
+        int n = user_n->ival[0];
+        bool record_deltas = deltas->count > 0;
+        arg_freetable(argtable, sizeof(argtable) / sizeof(argtable[0]));
+
+        server_state state;
+        memset(&state.stats, 0, sizeof(state.stats));
+        state.matcher = dynmatch_create(n, &options);
+        if( state.matcher == NULL ) {
+                std::cerr << "could not create matcher" << std::endl;
+                return 1;
+        }
+        if( record_deltas ) dynmatch_enable_deltas(state.matcher);
+
+        sockaddr_un address;
+        memset(&address, 0, sizeof(address));
+        address.sun_family = AF_UNIX;
+        if( path.size() >= sizeof(address.sun_path) ) {
+                std::cerr << "socket path too long" << std::endl;
+                return 1;
+        }
+        strcpy(address.sun_path, path.c_str());
+
+        int listen_fd = socket(AF_UNIX, SOCK_STREAM, 0);
+        unlink(path.c_str());
+        if( listen_fd < 0 || bind(listen_fd, (sockaddr *) &address, sizeof(address)) < 0 || listen(listen_fd, 16) < 0 ) {
+                perror("could not open socket");
+                return 1;
+        }
+
+        signal(SIGINT,  handle_signal);
+        signal(SIGTERM, handle_signal);
+        signal(SIGPIPE, SIG_IGN);
+        std::cout <<  "serving " << n << " nodes on " << path << std::endl;
+
+        // requests of all clients are served one at a time, so every query sees
+        // the matching after a complete update batch
+        std::vector< pollfd >     fds(1);
+        std::vector< connection > clients(1); // clients[i] belongs to fds[i], 0 is the listening socket
+        fds[0].fd     = listen_fd;
+        fds[0].events = POLLIN;
+        bool shutdown = false;
+        while( !shutdown && !stop_requested ) {
+                if( poll(fds.data(), fds.size(), 1000) < 0 ) {
+                        if( errno == EINTR ) continue;
+                        perror("poll");
+                        break;
+                }
+
+                for( size_t i = fds.size()-1; i > 0; i--) {
+                        if( fds[i].revents == 0 ) continue;
+                        connection & client = clients[i];
+                        bool open = send_queued(client);
+                        if( open && !client.backlogged() ) open = receive(client);
+                        bool keep = serve(client, state, shutdown);
+                        open = send_queued(client) && open;
+                        if( keep && open ) {
+                                // a backlogged client is only read from again once it
+                                // has read its answers
+                                fds[i].events = (client.backlogged() ? 0 : POLLIN)
+                                              | (client.outgoing_head < client.outgoing.size() ? POLLOUT : 0);
+                                continue;
+                        }
+
+                        close(fds[i].fd);
+                        fds[i] = fds.back();
+                        fds.pop_back();
+                        std::swap(clients[i], clients.back());
+                        clients.pop_back();
+                }
+
+                if( fds[0].revents & POLLIN ) {
+                        pollfd client;
+                        client.fd      = accept(listen_fd, NULL, NULL);
+                        client.events  = POLLIN;
+                        client.revents = 0;
+                        if( client.fd >= 0 ) {
+                                fds.push_back(client);
+                                clients.push_back(connection());
+                                clients.back().fd = client.fd;
+                        }
+                }
+        }
+
+        for( size_t i = 0; i < fds.size(); i++) {
+                close(fds[i].fd);
+        }
+        unlink(path.c_str());
+
+        std::cout <<  "applied " << state.stats.updates << " updates in " << state.stats.update_seconds << " s, "
+                  <<  "answered " << state.stats.queries << " queries, matching size " << dynmatch_matching_size(state.matcher) << std::endl;
+        dynmatch_destroy(state.matcher);
+
+        return 0;
+}
@@ -0,0 +1,551 @@
+/******************************************************************************
+ * micro_benchmarks.cpp
+ *
+ * Microbenchmarks for the building blocks of the dynamic matching algorithms:
+ * dyn_graph_access, node_bucket_pq, node_partition, blossom_base,
+ * random_functions, the free neighbor scan, the batch repair of
+ * rw_dyn_matching and the reader side of concurrent_matching. A replacement
+ * data structure should be measured here against the current one before it
+ * is merged.
+ *
+ *****************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+#include <cmath>
+#include <iomanip>
+#include <sstream>
+#include <iostream>
+#include <thread>
+#include <argtable3.h>
+#include <regex.h>
+
+#include "configuration.h"
+#include "definitions.h"
+#include "rw_dyn_matching.h"
+#include "data_structure/concurrent_matching.h"
+#include "data_structure/dyn_graph_access.h"
+#include "data_structure/blossom_base.h"
+#include "data_structure/node_partition.h"
+#include "data_structure/priority_queues/node_bucket_pq.h"
+#include "tools/neighbor_scan.h"
+#include "tools/random_functions.h"
+#include "tools/timer.h"
+
+struct BenchConfig {
+        NodeID n;
+        EdgeID m;
+        bool   powerlaw;
+        double skew;
+        double hit_ratio;
+        unsigned long long queries;
+        int    seed;
+};
+
+// keeps the optimizer from removing the measured loops
+static unsigned long long checksum = 0;
+
+static void report(const std::string & name, unsigned long long ops, double elapsed) {
+        double ns_per_op = ops > 0 ? (elapsed * 1e9) / ops : 0;
+        std::cout << std::left << std::setw(36) << name
+                  << std::right << std::setw(12) << ops << " ops "
+                  << std::setw(12) << std::fixed << std::setprecision(6) << elapsed << " s "
+                  << std::setw(10) << std::setprecision(2) << ns_per_op << " ns/op" << std::endl;
+        std::cout.unsetf(std::ios_base::floatfield);
+}
+
+// draws an endpoint either uniformly or skewed towards small ids, which yields
+// a heavy tailed degree distribution with a few hubs
+static NodeID random_endpoint(const BenchConfig & bc) {
+        if( !bc.powerlaw ) return random_functions::nextInt(0, bc.n-1);
+
+        double u = random_functions::nextDouble(0, 1);
+        NodeID v = (NodeID) (bc.n * std::pow(u, bc.skew));
+        return std::min(v, bc.n-1);
+}
+
+static void generate_edges(const BenchConfig & bc, std::vector< std::pair< NodeID, NodeID > > & edges) {
+        edges.clear();
+        edges.reserve(bc.m);
+        while( edges.size() < bc.m ) {
+                NodeID u = random_endpoint(bc);
+                NodeID v = random_endpoint(bc);
+                if( u == v ) continue;
+                edges.push_back(std::make_pair(u,v));
+        }
+}
+
+static void bench_dyn_graph_access(const BenchConfig & bc) {
+        std::vector< std::pair< NodeID, NodeID > > edges;
+        generate_edges(bc, edges);
+
+        dyn_graph_access G(bc.n);
+        timer t; t._restart();
+        for( EdgeID i = 0; i < edges.size(); i++) {
+                G.new_edge(edges[i].first, edges[i].second);
+                G.new_edge(edges[i].second, edges[i].first);
+        }
+        report("dyn_graph_access::new_edge", 2*edges.size(), t._elapsed());
+
+        EdgeID max_degree = 0;
+        forall_nodes(G, node) {
+                max_degree = std::max(max_degree, G.getNodeDegree(node));
+        } endfor
+        std::cout << "graph has " << G.number_of_nodes() << " nodes, " << G.number_of_edges()/2
+                  << " edges, max degree " << max_degree << std::endl;
+
+        // isEdge with a given fraction of queries hitting an existing edge
+        std::vector< std::pair< NodeID, NodeID > > queries(bc.queries);
+        for( unsigned long long i = 0; i < bc.queries; i++) {
+                if( random_functions::nextDouble(0, 1) < bc.hit_ratio ) {
+                        queries[i] = edges[random_functions::nextInt(0, edges.size()-1)];
+                } else {
+                        NodeID u = random_endpoint(bc);
+                        NodeID v = random_endpoint(bc);
+                        if( u == v ) v = (v + 1) % bc.n;
+                        queries[i] = std::make_pair(u, v);
+                }
+        }
+        t._restart();
+        unsigned long long hits = 0;
+        for( unsigned long long i = 0; i < bc.queries; i++) {
+                hits += G.isEdge(queries[i].first, queries[i].second);
+        }
+        report("dyn_graph_access::isEdge", bc.queries, t._elapsed());
+        std::cout << "isEdge hit ratio " << (double) hits / bc.queries << std::endl;
+        checksum += hits;
+
+        // getEdgeTarget, sequential scan of all neighborhoods
+        t._restart();
+        unsigned long long scanned = 0;
+        forall_nodes(G, node) {
+                forall_out_edges(G, e, node) {
+                        checksum += G.getEdgeTarget(node, e);
+                        scanned++;
+                } endfor
+        } endfor
+        report("dyn_graph_access::getEdgeTarget seq", scanned, t._elapsed());
+
+        // getEdgeTarget, random node and random slot, as done by random walks
+        std::vector< std::pair< NodeID, EdgeID > > slots(bc.queries);
+        for( unsigned long long i = 0; i < bc.queries; i++) {
+                std::pair< NodeID, NodeID > & edge = edges[random_functions::nextInt(0, edges.size()-1)];
+                NodeID node = edge.first;
+                slots[i] = std::make_pair(node, random_functions::nextInt(0, G.getNodeDegree(node)-1));
+        }
+        t._restart();
+        for( unsigned long long i = 0; i < bc.queries; i++) {
+                checksum += G.getEdgeTarget(slots[i].first, slots[i].second);
+        }
+        report("dyn_graph_access::getEdgeTarget rnd", bc.queries, t._elapsed());
+
+        // remove_edge with the same hit ratio, hits are reinserted afterwards
+        t._restart();
+        unsigned long long ops = 0;
+        for( unsigned long long i = 0; i < bc.queries; i++) {
+                ops++;
+                if( G.remove_edge(queries[i].first, queries[i].second) ) {
+                        G.new_edge(queries[i].first, queries[i].second);
+                        ops++;
+                }
+        }
+        report("dyn_graph_access::remove(+new)_edge", ops, t._elapsed());
+
+        random_functions::permutate_vector_anytype(edges);
+
+        t._restart();
+        for( EdgeID i = 0; i < edges.size(); i++) {
+                G.remove_edge(edges[i].first, edges[i].second);
+                G.remove_edge(edges[i].second, edges[i].first);
+        }
+        report("dyn_graph_access::remove_edge", 2*edges.size(), t._elapsed());
+}
+
+static void bench_node_bucket_pq(const BenchConfig & bc) {
+        // keys are degrees as in neimansolomon_dyn_matching
+        Gain max_key = std::max((EdgeID) 1, 2*bc.m/bc.n);
+        node_bucket_pq pq(bc.n, bc.n);
+
+        std::vector< Gain > keys(bc.n);
+        for( NodeID i = 0; i < bc.n; i++) {
+                keys[i] = random_functions::nextInt(0, max_key);
+        }
+
+        timer t; t._restart();
+        for( NodeID i = 0; i < bc.n; i++) {
+                pq.insert(i, keys[i]);
+        }
+        report("node_bucket_pq::insert", bc.n, t._elapsed());
+
+        std::vector< std::pair< NodeID, Gain > > changes(bc.queries);
+        for( unsigned long long i = 0; i < bc.queries; i++) {
+                changes[i] = std::make_pair(random_functions::nextInt(0, bc.n-1),
+                                            (Gain) random_functions::nextInt(0, max_key));
+        }
+        t._restart();
+        for( unsigned long long i = 0; i < bc.queries; i++) {
+                pq.changeKey(changes[i].first, changes[i].second);
+        }
+        report("node_bucket_pq::changeKey", bc.queries, t._elapsed());
+
+        // maxElement alone is loop invariant, so it is measured together with
+        // changeKey; the difference to the line above is its cost
+        t._restart();
+        for( unsigned long long i = 0; i < bc.queries; i++) {
+                pq.changeKey(changes[i].first, changes[i].second);
+                checksum += pq.maxElement();
+        }
+        report("node_bucket_pq::changeKey+maxElement", bc.queries, t._elapsed());
+
+        std::vector< NodeID > order(bc.n);
+        random_functions::permutate_vector_good(order, true);
+        t._restart();
+        for( NodeID i = 0; i < bc.n; i++) {
+                pq.deleteNode(order[i]);
+        }
+        report("node_bucket_pq::deleteNode", bc.n, t._elapsed());
+        checksum += pq.size();
+}
+
+// node_partition expands the blossoms of a search tree node by node, blossom_base
+// by starting a new generation
+static void reset_tree(node_partition & base, std::vector< NodeID > & T) { base.split(T); }
+static void reset_tree(blossom_base & base, std::vector< NodeID > & )   { base.reset(); }
+
+template< typename partition_type >
+static void bench_partition(const BenchConfig & bc, const std::string & name) {
+        dyn_graph_access G(bc.n);
+        partition_type base(&G);
+
+        std::vector< std::pair< NodeID, NodeID > > unions(bc.n/2);
+        for( NodeID i = 0; i < unions.size(); i++) {
+                unions[i] = std::make_pair(random_functions::nextInt(0, bc.n-1), random_functions::nextInt(0, bc.n-1));
+        }
+        timer t; t._restart();
+        for( NodeID i = 0; i < unions.size(); i++) {
+                base.union_blocks(unions[i].first, unions[i].second);
+        }
+        report(name + "::union_blocks", unions.size(), t._elapsed());
+
+        std::vector< NodeID > finds(bc.queries);
+        for( unsigned long long i = 0; i < bc.queries; i++) {
+                finds[i] = random_functions::nextInt(0, bc.n-1);
+        }
+        t._restart();
+        for( unsigned long long i = 0; i < bc.queries; i++) {
+                checksum += base.Find(finds[i]);
+        }
+        report(name + "::Find", bc.queries, t._elapsed());
+
+        // split resets a search tree, so we measure it on tree sized node sets
+        partition_type tree_base(&G);
+        NodeID tree_size = std::min((NodeID) 1024, bc.n);
+        std::vector< NodeID > T(tree_size);
+        unsigned long long rounds = std::max(1ULL, bc.queries / tree_size);
+        t._restart();
+        for( unsigned long long r = 0; r < rounds; r++) {
+                NodeID offset = random_functions::nextInt(0, bc.n - tree_size);
+                for( NodeID i = 0; i < tree_size; i++) {
+                        T[i] = offset + i;
+                }
+                for( NodeID i = 1; i < tree_size; i++) {
+                        tree_base.union_blocks(T[i-1], T[i]);
+                }
+                reset_tree(tree_base, T);
+        }
+        report(name + "::union+reset (1024)", rounds*tree_size, t._elapsed());
+}
+
+static void bench_random_functions(const BenchConfig & bc) {
+        std::vector< unsigned > bounds(1024);
+        for( unsigned i = 0; i < bounds.size(); i++) {
+                bounds[i] = random_endpoint(bc) + 1;
+        }
+
+        // reference: what nextInt did before the engines were pluggable
+        std::mt19937 mt(bc.seed);
+        timer t; t._restart();
+        for( unsigned long long i = 0; i < bc.queries; i++) {
+                std::uniform_int_distribution<unsigned int> A(0, bounds[i & 1023]);
+                checksum += A(mt);
+        }
+        report("std::uniform_int_distribution<mt19937>", bc.queries, t._elapsed());
+
+        const RandomEngineType engines[] = {RNG_XOSHIRO256SS, RNG_PCG32, RNG_SPLITMIX64, RNG_MT19937, RNG_PHILOX4X32};
+        const char * names[]             = {"xoshiro256ss", "pcg32", "splitmix64", "mt19937", "philox4x32"};
+        RandomEngineType previous        = random_functions::get_stream().engine;
+        for( unsigned e = 0; e < 5; e++) {
+                random_functions::setEngine(engines[e]);
+                t._restart();
+                for( unsigned long long i = 0; i < bc.queries; i++) {
+                        checksum += random_functions::nextInt(0, bounds[i & 1023]);
+                }
+                report(std::string("random_functions::nextInt<") + names[e] + ">", bc.queries, t._elapsed());
+
+                // what the walks do: the stream is looked up once per walk
+                random_functions::stream & rng = random_functions::get_stream();
+                t._restart();
+                for( unsigned long long i = 0; i < bc.queries; i++) {
+                        checksum += rng.bounded(bounds[i & 1023] + 1);
+                }
+                report(std::string("random_functions::stream::bounded<") + names[e] + ">", bc.queries, t._elapsed());
+        }
+        random_functions::setEngine(previous);
+}
+
+// scans of a hub whose neighbors are all matched but the last one, with
+// every kernel the cpu supports
+static void bench_neighbor_scan(const BenchConfig & bc) {
+        const size_t degrees[] = {16, 256, 4096, 65536};
+
+        std::vector< NodeID > matching(bc.n, 0);
+        std::vector< DynEdge > edges;
+        for( size_t degree : degrees ) {
+                std::fill(matching.begin(), matching.end(), 0);
+                edges.resize(degree);
+                for( size_t i = 0; i < degree; i++) {
+                        edges[i].target = random_functions::nextInt(0, bc.n-1);
+                }
+                matching[edges[degree-1].target] = NOMATE;
+                unsigned long long scans = std::max< unsigned long long >(1, bc.queries / degree);
+
+                const ScanKernelType kernels[] = {SCAN_SCALAR, SCAN_AVX2, SCAN_AVX512};
+                const char * names[]           = {"scalar", "avx2", "avx512"};
+                ScanKernelType previous        = neighbor_scan::get_kernel();
+                for( unsigned k = 0; k < 3; k++) {
+                        if( !neighbor_scan::supported(kernels[k]) ) continue;
+                        neighbor_scan::set_kernel(kernels[k]);
+
+                        timer t; t._restart();
+                        for( unsigned long long i = 0; i < scans; i++) {
+                                checksum += neighbor_scan::first_free(edges.data(), degree, matching, NOMATE);
+                        }
+                        std::stringstream name;
+                        name << "neighbor_scan<" << names[k] << "> (degree " << degree << ")";
+                        report(name.str(), scans*degree, t._elapsed());
+                }
+                neighbor_scan::set_kernel(previous);
+        }
+}
+
+// deletes a fifth of the edges of a greedy matching as one batch and repairs
+// the freed nodes with walks of up to 20 steps: with the walks of single
+// deletions (group 0), one walk after the other and in interleaved groups.
+// every group size starts from the same graph, matching and seed. group 1
+// has to give the matching of group 0, larger groups draw in another order
+// and print their size for comparison
+static void bench_walk_repair(const BenchConfig & bc) {
+        std::vector< std::pair< NodeID, NodeID > > edges;
+        generate_edges(bc, edges);
+
+        dyn_graph_access G(bc.n);
+        for( size_t i = 0; i < edges.size(); i++) {
+                G.new_edge(edges[i].first, edges[i].second);
+                G.new_edge(edges[i].second, edges[i].first);
+        }
+
+        std::vector< NodeID > initial(bc.n, NOMATE);
+        std::vector< std::pair< NodeID, NodeID > > batch;
+        for( size_t i = 0; i < edges.size(); i++) {
+                NodeID u = edges[i].first, v = edges[i].second;
+                if( initial[u] != NOMATE || initial[v] != NOMATE ) continue;
+                initial[u] = v;
+                initial[v] = u;
+                if( random_functions::nextInt(0, 4) == 0 ) batch.push_back(edges[i]);
+        }
+
+        MatchConfig config;
+        configuration cfg;
+        cfg.standard(config);
+        config.rw_max_length = 20;
+
+        std::vector< NodeID > reference;
+        const int groups[] = {0, 1, 4, 16, 64};
+        for( int group : groups ) {
+                config.rw_walk_group = group;
+                rw_dyn_matching algorithm(&G, config);
+                algorithm.init_matching(initial);
+                random_functions::setSeed(bc.seed);
+
+                timer t; t._restart();
+                algorithm.remove_edges(batch);
+                double elapsed = t._elapsed();
+                checksum += algorithm.getMSize();
+
+                std::stringstream name;
+                name << "rw::remove_edges (group " << group << ", size " << algorithm.getMSize() << ")";
+                report(name.str(), 2*batch.size(), elapsed);
+
+                if( group == 0 ) {
+                        reference = algorithm.getM();
+                } else if( group == 1 && algorithm.getM() != reference ) {
+                        std::cerr << "rw::remove_edges: group 1 differs from the walks of single deletions" << std::endl;
+                        exit(1);
+                }
+
+                for( size_t i = 0; i < batch.size(); i++) {
+                        G.new_edge(batch[i].first, batch[i].second);
+                        G.new_edge(batch[i].second, batch[i].first);
+                }
+        }
+}
+
+// one writer replays all edges as insertions and then as deletions through
+// rw_dyn_matching and publishes the changes of every batch, while the reader threads
+// issue mate queries against the published matching
+static void run_concurrent_matching(const BenchConfig & bc, const std::vector< std::pair< NodeID, NodeID > > & edges, unsigned readers) {
+        const unsigned batch = 1000;
+
+        MatchConfig config;
+        configuration cfg;
+        cfg.standard(config);
+        config.seed = bc.seed;
+        random_functions::setSeed(bc.seed);
+
+        dyn_graph_access G(bc.n);
+        rw_dyn_matching algorithm(&G, config);
+        concurrent_matching snapshot(bc.n);
+        std::vector< MatchingDelta > deltas;
+        algorithm.log_deltas(true);
+
+        std::atomic< bool > done(false);
+        std::vector< unsigned long long > answered(readers, 0);
+        std::vector< std::thread > threads;
+        for( unsigned r = 0; r < readers; r++) {
+                threads.push_back(std::thread([&, r]() {
+                        unsigned long long local_checksum = 0, count = 0;
+                        NodeID u = r;
+                        while( !done.load(std::memory_order_relaxed) ) {
+                                u = (u * 2654435761u + 1) % bc.n;
+                                local_checksum += snapshot.mate(u);
+                                count++;
+                        }
+                        answered[r] = count + (local_checksum & 1);
+                }));
+        }
+
+        timer t; t._restart();
+        unsigned long long updates = 0;
+        for( int phase = 0; phase < 2; phase++) {
+                for( size_t start = 0; start < edges.size(); start += batch) {
+                        size_t stop = std::min(edges.size(), start + batch);
+                        for( size_t i = start; i < stop; i++) {
+                                NodeID u = edges[i].first, v = edges[i].second;
+                                if( phase == 0 && !G.isEdge(u,v) )     { algorithm.new_edge(u,v);    updates++; }
+                                else if( phase == 1 && G.isEdge(u,v) ) { algorithm.remove_edge(u,v); updates++; }
+                        }
+                        algorithm.drain_deltas(deltas);
+                        snapshot.publish(deltas, algorithm.getMSize());
+                }
+        }
+        double elapsed = t._elapsed();
+        done.store(true);
+
+        unsigned long long queries = 0;
+        for( unsigned r = 0; r < readers; r++) {
+                threads[r].join();
+                queries += answered[r];
+        }
+        checksum += snapshot.epoch();
+
+        std::stringstream name;
+        name << "concurrent_matching::update (" << readers << "r)";
+        report(name.str(), updates, elapsed);
+        if( readers > 0 ) {
+                name.str("");
+                name << "concurrent_matching::mate (" << readers << "r)";
+                report(name.str(), queries, elapsed);
+        }
+}
+
+static void bench_concurrent_matching(const BenchConfig & bc) {
+        BenchConfig small = bc;
+        small.m = std::min(bc.m, (EdgeID) 1000000);
+        std::vector< std::pair< NodeID, NodeID > > edges;
+        generate_edges(small, edges);
+
+        // the writer keeps one core, the readers get the rest
+        unsigned cores = std::thread::hardware_concurrency();
+        unsigned max_readers = cores > 2 ? cores - 1 : 1;
+        for( unsigned readers = 0; readers <= max_readers; readers = readers == 0 ? 1 : 2*readers) {
+                run_concurrent_matching(bc, edges, readers);
+        }
+}
+
+int main(int argn, char **argv)
+{
+        const char *progname = argv[0];
+
+        // Setup argtable parameters.
+        struct arg_lit *help                        = arg_lit0(NULL, "help","Print help.");
+        struct arg_int *user_n                      = arg_int0(NULL, "n", NULL, "Number of nodes (default 1000000).");
+        struct arg_dbl *avg_degree                  = arg_dbl0(NULL, "avg_degree", NULL, "Average degree of the generated graph (default 16).");
+        struct arg_rex *distribution                = arg_rex0(NULL, "distribution", "^(uniform|powerlaw)$", "TYPE", REG_EXTENDED, "Degree distribution. One of {uniform, powerlaw} (default uniform).");
+        struct arg_dbl *skew                        = arg_dbl0(NULL, "skew", NULL, "Skew of the powerlaw distribution, larger is more skewed (default 3).");
+        struct arg_dbl *hit_ratio                   = arg_dbl0(NULL, "hit_ratio", NULL, "Fraction of edge queries that hit an existing edge (default 0.5).");
+        struct arg_int *queries                     = arg_int0(NULL, "queries", NULL, "Number of queries per benchmark (default 10000000).");
+        struct arg_int *user_seed                   = arg_int0(NULL, "seed", NULL, "Seed to use for the PRNG.");
+        struct arg_rex *only                        = arg_rex0(NULL, "only", "^(graph|pq|partition|random|scan|walks|concurrent)$", "PRIMITIVE", REG_EXTENDED, "Only run the benchmarks of one primitive. One of {graph, pq, partition, random, scan, walks, concurrent}.");
+        struct arg_end *end                         = arg_end(100);
+
+        // Define argtable.
+        void* argtable[] = {
+                help, user_n, avg_degree, distribution, skew, hit_ratio, queries, user_seed, only, end
+        };
+        // Parse arguments.
+        int nerrors = arg_parse(argn, argv, argtable);
+
+        // Catch case that help was requested.
+        if (help->count > 0) {
+                printf("Usage: %s", progname);
+                arg_print_syntax(stdout, argtable, "\n");
+                arg_print_glossary(stdout, argtable,"  %-40s %s\n");
+                arg_freetable(argtable, sizeof(argtable) / sizeof(argtable[0]));
+                return 1;
+        }
+
+        if (nerrors > 0) {
+                arg_print_errors(stderr, end, progname);
+                printf("Try '%s --help' for more information.\n",progname);
+                arg_freetable(argtable, sizeof(argtable) / sizeof(argtable[0]));
+                return 1;
+        }
+
+        BenchConfig bc;
+        bc.n         = user_n->count > 0     ? user_n->ival[0]     : 1000000;
+        bc.m         = (EdgeID) ((avg_degree->count > 0 ? avg_degree->dval[0] : 16) * bc.n / 2);
+        bc.powerlaw  = distribution->count > 0 && strcmp("powerlaw", distribution->sval[0]) == 0;
+        bc.skew      = skew->count > 0       ? skew->dval[0]       : 3;
+        bc.hit_ratio = hit_ratio->count > 0  ? hit_ratio->dval[0]  : 0.5;
+        bc.queries   = queries->count > 0    ? queries->ival[0]    : 10000000;
+        bc.seed      = user_seed->count > 0  ? user_seed->ival[0]  : 0;
+        std::string selected = only->count > 0 ? only->sval[0] : "";
+        arg_freetable(argtable, sizeof(argtable) / sizeof(argtable[0]));
+
+        if( bc.n < 2 || bc.m < 1 ) {
+                std::cerr << "graph needs at least two nodes and one edge" << std::endl;
+                return 1;
+        }
+
+        srand(bc.seed);
+        random_functions::setSeed(bc.seed);
+
+        std::cout << "n " << bc.n << " m " << bc.m << " distribution " << (bc.powerlaw ? "powerlaw" : "uniform")
+                  << " hit_ratio " << bc.hit_ratio << " queries " << bc.queries << std::endl;
+
+        if( selected == "" || selected == "graph" )     bench_dyn_graph_access(bc);
+        if( selected == "" || selected == "pq" )        bench_node_bucket_pq(bc);
+        if( selected == "" || selected == "partition" ) {
+                bench_partition< node_partition >(bc, "node_partition");
+                bench_partition< blossom_base >(bc, "blossom_base");
+        }
+        if( selected == "" || selected == "random" )    bench_random_functions(bc);
+        if( selected == "" || selected == "scan" )      bench_neighbor_scan(bc);
+        if( selected == "" || selected == "walks" )     bench_walk_repair(bc);
+        if( selected == "" || selected == "concurrent" ) bench_concurrent_matching(bc);
+
+        std::cout << "checksum " << checksum << std::endl;
+
+        return 0;
+}
+
@@ -9,6 +9,7 @@
 #ifndef PARSE_PARAMETERS_GPJMGSM8_MATCH
 #define PARSE_PARAMETERS_GPJMGSM8_MATCH
 
+#include <algorithm>
 #include <omp.h>
 #include <sstream>
 #include <argtable3.h>
@@ -26,25 +27,64 @@ int parse_parameters(int argn, char **argv,
         struct arg_lit *help                        = arg_lit0(NULL, "help","Print help.");
         struct arg_str *filename                    = arg_strn(NULL, NULL, "FILE", 1, 1, "Path to graph file to compute matching from.");
         struct arg_int *user_seed                   = arg_int0(NULL, "seed", NULL, "Seed to use for the PRNG.");
-        struct arg_rex *algorithm_type              = arg_rex1(NULL, "algorithm", "^(staticblossom|dynblossom|naive|randomwalk|neimansolomon|baswanaguptasen)$", "TYPE", REG_EXTENDED, "Algorithm to use. One of {staticblossom, dynblossom, randomwalk, neimansolomon, baswanaguptasen}"  );
+        struct arg_rex *rng                         = arg_rex0(NULL, "rng", "^(xoshiro256ss|pcg32|splitmix64|mt19937|philox4x32)$", "TYPE", REG_EXTENDED, "Random engine. One of {xoshiro256ss, pcg32, splitmix64, mt19937, philox4x32}. Default: xoshiro256ss (set by cmake -DRNG_ENGINE). The parallel batch repair of randomwalk always uses philox4x32."  );
+        struct arg_rex *algorithm_type              = arg_rex1(NULL, "algorithm", "^(staticblossom|dynblossom|naive|randomwalk|neimansolomon|baswanaguptasen)$", "TYPE", REG_EXTENDED, "Algorithm to use. One of {staticblossom, dynblossom, naive, randomwalk, neimansolomon, baswanaguptasen}"  );
 
         struct arg_dbl *eps                         = arg_dbl0(NULL, "eps", NULL, "Epsilon. Limit search depth of random walk or augmenting path search in dynblossom to 2/eps-1.");
         struct arg_lit *dynblossom_speedheuristic   = arg_lit0(NULL, "dynblossom_lazy","Lazy approach for dynblossom, i.e. only start augmenting path searchs after x newly inserted edges on an endpoint.");
         //struct arg_lit *dynblossom_weakspeedheuristic = arg_lit0(NULL, "dynblossom_weakspeedheuristic","WeakSpeedHeuristic for dynblossom.");
         struct arg_lit *dynblossom_maintain_opt     = arg_lit0(NULL, "dynblossom_maintain_opt","Maintain optimum in dynblossom. (Without this option the algorithm is called UNSAFE.)");
+        struct arg_lit *dynblossom_reuse_forest     = arg_lit0(NULL, "dynblossom_reuse_forest","Keep the search trees of failed searches in dynblossom until an update touches them.");
+        struct arg_int *dynblossom_repair_budget    = arg_int0(NULL, "dynblossom_repair_budget", NULL, "With --dynblossom_lazy, free nodes whose search was skipped are queued by degree and this many of them are searched in every skipped update. Default: 0.");
+        struct arg_int *dynblossom_repair_edges     = arg_int0(NULL, "dynblossom_repair_edges", NULL, "Edges each search of --dynblossom_repair_budget may scan before it gives up. Default: 256.");
+        struct arg_lit *dynblossom_lazy_drain       = arg_lit0(NULL, "dynblossom_lazy_drain", "With --dynblossom_lazy, search from all queued free nodes after the last update.");
+        struct arg_int *dynblossom_local_budget     = arg_int0(NULL, "dynblossom_local_budget", NULL, "Edges the local search through a new edge between matched nodes may scan before the global search of --dynblossom_maintain_opt takes over, 0 disables it. Default: 4096.");
+        struct arg_rex *blossom_init                = arg_rex0(NULL, "blossom_init", "^(empty|greedy|extragreedy|karpsipser)$", "TYPE", REG_EXTENDED, "Initial matching of the static blossom algorithm. One of {empty, greedy, extragreedy (min degree), karpsipser}. Default: extragreedy."  );
+        struct arg_rex *static_engine               = arg_rex0(NULL, "static_engine", "^(edmonds|phases|parallel)$", "TYPE", REG_EXTENDED, "Exact solver of staticblossom and --post_blossom. One of {edmonds (one tree per free node), phases (forest of all free nodes per phase), parallel (concurrent trees, see --threads)}. Default: edmonds."  );
+        struct arg_int *threads                     = arg_int0(NULL, "threads", NULL, "Number of threads of --static_engine=parallel and of the batch repair of randomwalk. Default: 1.");
+        struct arg_int *rw_walk_group               = arg_int0(NULL, "rw_walk_group", NULL, "Number of walks that randomwalk advances together, with prefetching, when it repairs a deletion batch. 1 repairs the freed nodes one after the other, 0 does the same with the walks of single deletions (gives the same matching as 1). Default: 16.");
+        struct arg_lit *free_neighbor_counts        = arg_lit0(NULL, "free_neighbor_counts", "Count the free neighbors of the nodes of degree 64 and more (until their degree drops below 32) so that naive, randomwalk and baswanaguptasen skip their scans for a free neighbor when there is none. Matching or freeing a node costs its counted neighbors.");
+        struct arg_int *batch_size                  = arg_int0(NULL, "batch_size", NULL, "Hand runs of up to this many consecutive deletions to the algorithm at once. randomwalk repairs the freed nodes of a batch with concurrent walks. Default: 1.");
+        struct arg_lit *post_blossom                = arg_lit0(NULL, "post_blossom","Compute a maximum matching with the static solver after the last update, starting from the dynamic matching.");
         struct arg_dbl *bgs_factor                  = arg_dbl0(NULL, "bgs_factor", NULL, "BGS factor.");
 
         struct arg_lit *measure_graph_only          = arg_lit0(NULL, "measure_graph_only","Only measure graph construction time.");
+        struct arg_lit *bulk_load                   = arg_lit0(NULL, "bulk_load","Bulk load the insert-only prefix of the sequence and compute its matching statically before going dynamic.");
+        struct arg_int *bulk_load_prefix            = arg_int0(NULL, "bulk_load_prefix", NULL, "Bulk load at most this many updates (implies --bulk_load). Default: the whole insert-only prefix.");
+        struct arg_str *sides                       = arg_str0(NULL, "sides", NULL, "File with the side (0 or 1) of every node, one per line. The graph is bipartite, use the bipartite engines.");
+        struct arg_lit *no_bipartite                = arg_lit0(NULL, "no_bipartite", "Do not check whether the graph is bipartite, always use the general engines.");
+        struct arg_str *checkpoint                  = arg_str0(NULL, "checkpoint", NULL, "Write a checkpoint of the graph and the algorithm state to this file after the last update.");
+        struct arg_int *checkpoint_every            = arg_int0(NULL, "checkpoint_every", NULL, "Also write the checkpoint every x updates, in the background.");
+        struct arg_str *restore                     = arg_str0(NULL, "restore", NULL, "Continue from this checkpoint instead of replaying the sequence from the first update.");
         struct arg_end *end                         = arg_end(100);
 
         // Define argtable.
         void* argtable[] = {
-                help, filename, user_seed, algorithm_type, 
+                help, filename, user_seed, rng, algorithm_type, 
                 eps, 
                 dynblossom_speedheuristic, 
                 //dynblossom_weakspeedheuristic, 
                 dynblossom_maintain_opt, 
+                dynblossom_repair_budget,
+                dynblossom_repair_edges,
+                dynblossom_lazy_drain,
+                dynblossom_reuse_forest,
+                dynblossom_local_budget,
+                blossom_init,
+                static_engine,
+                threads,
+                batch_size,
+                free_neighbor_counts,
+                rw_walk_group,
+                post_blossom,
                 measure_graph_only, 
+                bulk_load,
+                bulk_load_prefix,
+                sides,
+                no_bipartite,
+                checkpoint,
+                checkpoint_every,
+                restore,
                 end
         };
         // Parse arguments.
@@ -85,6 +125,9 @@ int parse_parameters(int argn, char **argv,
                         match_config.algorithm = DYNBLOSSOM;
                         match_config.rw_max_length = std::numeric_limits< int >::max() / 2;
                         std::cout <<  "running dynamic blossom algorithm"  << std::endl;
+                } else if (strcmp("naive", algorithm_type->sval[0]) == 0) {
+                        match_config.algorithm = NAIVE;
+                        std::cout <<  "running dynamic naive"  << std::endl;
                 } else if (strcmp("neimansolomon", algorithm_type->sval[0]) == 0) {
                         match_config.algorithm = NEIMAN_SOLOMON;
                         std::cout <<  "running dynamic neiman solomon"  << std::endl;
@@ -109,6 +152,20 @@ int parse_parameters(int argn, char **argv,
                 match_config.seed = user_seed->ival[0];
         }
 
+        if(rng->count > 0) {
+                if(strcmp("pcg32", rng->sval[0]) == 0) {
+                        match_config.rng_engine = RNG_PCG32;
+                } else if(strcmp("splitmix64", rng->sval[0]) == 0) {
+                        match_config.rng_engine = RNG_SPLITMIX64;
+                } else if(strcmp("mt19937", rng->sval[0]) == 0) {
+                        match_config.rng_engine = RNG_MT19937;
+                } else if(strcmp("philox4x32", rng->sval[0]) == 0) {
+                        match_config.rng_engine = RNG_PHILOX4X32;
+                } else {
+                        match_config.rng_engine = RNG_XOSHIRO256SS;
+                }
+        }
+
         if(dynblossom_speedheuristic->count > 0) {
                 match_config.dynblossom_speedheuristic = true;
         }
@@ -121,6 +178,97 @@ int parse_parameters(int argn, char **argv,
                 match_config.maintain_opt = true;
         }
 
+        if(dynblossom_repair_budget->count > 0) {
+                match_config.dynblossom_repair_budget = std::max(dynblossom_repair_budget->ival[0], 0);
+        }
+
+        if(dynblossom_repair_edges->count > 0) {
+                match_config.dynblossom_repair_edges = std::max(dynblossom_repair_edges->ival[0], 1);
+        }
+
+        if(dynblossom_lazy_drain->count > 0) {
+                match_config.dynblossom_lazy_drain = true;
+        }
+
+        if(dynblossom_reuse_forest->count > 0) {
+                match_config.dynblossom_reuse_forest = true;
+        }
+
+        if(dynblossom_local_budget->count > 0) {
+                match_config.dynblossom_local_budget = std::max(dynblossom_local_budget->ival[0], 0);
+        }
+
+        if(blossom_init->count > 0) {
+                if(strcmp("empty", blossom_init->sval[0]) == 0) {
+                        match_config.blossom_init = BLOSSOMEMPTY;
+                } else if(strcmp("greedy", blossom_init->sval[0]) == 0) {
+                        match_config.blossom_init = BLOSSOMGREEDY;
+                } else if(strcmp("extragreedy", blossom_init->sval[0]) == 0) {
+                        match_config.blossom_init = BLOSSOMEXTRAGREEDY;
+                } else if(strcmp("karpsipser", blossom_init->sval[0]) == 0) {
+                        match_config.blossom_init = BLOSSOMKARPSIPSER;
+                }
+        }
+
+        if(static_engine->count > 0) {
+                if(strcmp("phases", static_engine->sval[0]) == 0) {
+                        match_config.static_engine = STATIC_PHASES;
+                } else if(strcmp("parallel", static_engine->sval[0]) == 0) {
+                        match_config.static_engine = STATIC_PARALLEL;
+                } else {
+                        match_config.static_engine = STATIC_EDMONDS;
+                }
+        }
+
+        if(threads->count > 0) {
+                match_config.threads = threads->ival[0];
+        }
+
+        if(free_neighbor_counts->count > 0) {
+                match_config.free_neighbor_counts = true;
+        }
+
+        if(batch_size->count > 0) {
+                match_config.batch_size = std::max(batch_size->ival[0], 1);
+        }
+
+        if(rw_walk_group->count > 0) {
+                match_config.rw_walk_group = std::max(rw_walk_group->ival[0], 0);
+        }
+
+        if(post_blossom->count > 0) {
+                match_config.post_blossom = true;
+        }
+
+        if(bulk_load->count > 0) {
+                match_config.bulk_load = true;
+        }
+
+        if(bulk_load_prefix->count > 0 && bulk_load_prefix->ival[0] > 0) {
+                match_config.bulk_load        = true;
+                match_config.bulk_load_prefix = bulk_load_prefix->ival[0];
+        }
+
+        if(sides->count > 0) {
+                match_config.sides_filename = sides->sval[0];
+        }
+
+        if(no_bipartite->count > 0) {
+                match_config.bipartite_detection = false;
+        }
+
+        if(checkpoint->count > 0) {
+                match_config.checkpoint_filename = checkpoint->sval[0];
+        }
+
+        if(checkpoint_every->count > 0 && checkpoint_every->ival[0] > 0) {
+                match_config.checkpoint_every = checkpoint_every->ival[0];
+        }
+
+        if(restore->count > 0) {
+                match_config.restore_filename = restore->sval[0];
+        }
+
         if(bgs_factor->count > 0) {
                 match_config.bgs_factor = bgs_factor->dval[0];
         }
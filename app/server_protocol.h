@@ -0,0 +1,105 @@
+/******************************************************************************
+ * server_protocol.h
+ *
+ * Binary protocol between dynmatch_server and its clients. Both ends live on
+ * the same machine (Unix domain socket), so all words are in host byte order.
+ *
+ * Every request is a request_header followed by header.count records:
+ *   MSG_UPDATES   count x update_record        -> count = number of applied updates,
+ *                                                  payload = current matching size
+ *   MSG_MATES     count x uint32 node          -> count x uint32 mate (NOMATE if free)
+ *   MSG_SIZE      no payload                   -> payload = current matching size
+ *   MSG_STATS     no payload                   -> payload = server_stats
+ *   MSG_SHUTDOWN  no payload                   -> empty answer, server exits
+ *   MSG_DELTAS    no payload, count = maximum  -> count x delta_record, the changes of the
+ *                                                  matching since the last MSG_DELTAS
+ *                                                  (server started with --deltas)
+ * Every answer is a response_header followed by its payload.
+ *
+ *****************************************************************************/
+
+#ifndef SERVER_PROTOCOL_Q8ZT4WNB
+#define SERVER_PROTOCOL_Q8ZT4WNB
+
+#include <errno.h>
+#include <stdint.h>
+#include <unistd.h>
+
+enum {
+        MSG_UPDATES  = 1,
+        MSG_MATES    = 2,
+        MSG_SIZE     = 3,
+        MSG_STATS    = 4,
+        MSG_SHUTDOWN = 5,
+        MSG_DELTAS   = 6
+};
+
+enum {
+        STATUS_OK          = 0,
+        STATUS_BAD_REQUEST = 1
+};
+
+// upper bound on records per request, larger batches have to be split
+const uint32_t MAX_RECORDS_PER_MESSAGE = 1 << 24;
+
+struct request_header {
+        uint32_t type;
+        uint32_t count;
+};
+
+struct response_header {
+        uint32_t status;
+        uint32_t count;
+};
+
+struct update_record {
+        uint32_t insert; // 1 insertion, 0 deletion
+        uint32_t u;
+        uint32_t v;
+};
+
+struct delta_record {
+        uint32_t u;
+        uint32_t v;
+        uint32_t matched; // 1 {u,v} became matched, 0 unmatched
+};
+
+struct server_stats {
+        uint64_t updates;            // applied updates
+        uint64_t update_batches;
+        uint64_t queries;            // answered mate queries
+        uint64_t query_batches;
+        uint64_t matching_size;
+        double   update_seconds;     // time spent applying updates
+        double   query_seconds;      // time spent answering mate queries
+        double   batch_latency_p50;  // seconds per update batch
+        double   batch_latency_p99;
+        double   batch_latency_max;
+};
+
+// blocking helpers that retry on short reads/writes, return false on EOF or error
+inline bool read_fully(int fd, void * buffer, size_t bytes) {
+        char * pos = (char *) buffer;
+        while( bytes > 0 ) {
+                ssize_t r = read(fd, pos, bytes);
+                if( r < 0 && errno == EINTR ) continue;
+                if( r <= 0 ) return false;
+                pos   += r;
+                bytes -= r;
+        }
+        return true;
+}
+
+inline bool write_fully(int fd, const void * buffer, size_t bytes) {
+        const char * pos = (const char *) buffer;
+        while( bytes > 0 ) {
+                ssize_t w = write(fd, pos, bytes);
+                if( w < 0 && errno == EINTR ) continue;
+                if( w <= 0 ) return false;
+                pos   += w;
+                bytes -= w;
+        }
+        return true;
+}
+
+#endif /* end of include guard: SERVER_PROTOCOL_Q8ZT4WNB */
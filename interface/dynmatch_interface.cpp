@@ -0,0 +1,278 @@
+/******************************************************************************
+ * dynmatch_interface.cpp
+ *
+ *****************************************************************************/
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "dynmatch_interface.h"
+#include "configuration.h"
+#include "data_structure/concurrent_matching.h"
+#include "data_structure/dyn_graph_access.h"
+#include "dyn_matching.h"
+#include "baswanaguptasen_dyn_matching.h"
+#include "blossom_dyn_matching.h"
+#include "naive_dyn_matching.h"
+#include "neimansolomon_dyn_matching.h"
+#include "rw_dyn_matching.h"
+#include "static_blossom.h"
+#include "tools/random_functions.h"
+
+struct dynmatch_matcher {
+        dyn_graph_access * G;
+        dyn_matching     * algorithm;
+        MatchConfig        config;
+
+        // every call that may draw random numbers runs on this stream
+        random_functions::stream rng;
+
+        // published matching for concurrent readers, NULL unless enabled
+        concurrent_matching * snapshot;
+
+        // changes of the last update call and the ones not yet drained by the user
+        std::vector< MatchingDelta > deltas;
+        std::vector< MatchingDelta > pending;
+        size_t pending_start;
+        bool   record_deltas;
+};
+
+// called at the end of every update call, hands the changes of the matching
+// to the published copy and to the user
+static void publish(dynmatch_matcher * matcher) {
+        if( matcher->snapshot == NULL && !matcher->record_deltas ) return;
+
+        matcher->algorithm->drain_deltas(matcher->deltas);
+        if( matcher->snapshot != NULL ) {
+                matcher->snapshot->publish(matcher->deltas, matcher->algorithm->getMSize());
+        }
+        if( matcher->record_deltas ) {
+                matcher->pending.insert(matcher->pending.end(), matcher->deltas.begin(), matcher->deltas.end());
+        }
+}
+
+static int check_edge(const dynmatch_matcher * matcher, unsigned u, unsigned v) {
+        if( matcher == NULL ) return DYNMATCH_INVALID_HANDLE;
+        if( u >= matcher->G->number_of_nodes() || v >= matcher->G->number_of_nodes() ) return DYNMATCH_INVALID_NODE;
+        if( u == v ) return DYNMATCH_SELF_LOOP;
+        return DYNMATCH_OK;
+}
+
+// the algorithms expect valid updates, i.e. no duplicate insertions and no
+// deletions of missing edges, so those are filtered out here
+static int insert_edge(dynmatch_matcher * matcher, unsigned u, unsigned v) {
+        if( matcher->G->isEdge(u, v) ) return 0;
+        matcher->algorithm->new_edge(u, v);
+        return 1;
+}
+
+static int remove_edge(dynmatch_matcher * matcher, unsigned u, unsigned v) {
+        if( !matcher->G->isEdge(u, v) ) return 0;
+        matcher->algorithm->remove_edge(u, v);
+        return 1;
+}
+
+void dynmatch_default_options(dynmatch_options * options) {
+        MatchConfig config;
+        configuration cfg;
+        cfg.standard(config);
+
+        options->algorithm    = DYNMATCH_RANDOM_WALK;
+        options->seed         = config.seed;
+        options->eps          = 0;
+        options->maintain_opt = config.maintain_opt;
+        options->lazy         = config.dynblossom_speedheuristic;
+        options->bgs_factor   = config.bgs_factor;
+}
+
+dynmatch_matcher * dynmatch_create(unsigned n, const dynmatch_options * options) {
+        dynmatch_options defaults;
+        if( options == NULL ) {
+                dynmatch_default_options(&defaults);
+                options = &defaults;
+        }
+
+        dynmatch_matcher * matcher = NULL;
+        try {
+                matcher = new dynmatch_matcher();
+                matcher->G = NULL;
+                matcher->algorithm = NULL;
+                matcher->snapshot = NULL;
+                matcher->pending_start = 0;
+                matcher->record_deltas = false;
+
+                MatchConfig & config = matcher->config;
+                configuration cfg;
+                cfg.standard(config);
+                config.seed                      = options->seed;
+                config.maintain_opt              = options->maintain_opt != 0;
+                config.dynblossom_speedheuristic = options->lazy != 0;
+                config.bgs_factor                = options->bgs_factor;
+
+                // same settings as parse_parameters
+                if( options->algorithm == DYNMATCH_DYNBLOSSOM ) {
+                        config.rw_max_length = std::numeric_limits< int >::max() / 2;
+                }
+                if( options->eps > 0 ) {
+                        config.rw_max_length = ceil(2.0/options->eps - 1.0);
+                }
+
+                matcher->rng.engine = config.rng_engine;
+                matcher->rng.seed(config.seed);
+                matcher->G = new dyn_graph_access(n);
+
+                switch( options->algorithm ) {
+                        case DYNMATCH_RANDOM_WALK:
+                                config.algorithm = RANDOM_WALK;
+                                matcher->algorithm = new rw_dyn_matching(matcher->G, config);
+                                break;
+                        case DYNMATCH_BASWANA_GUPTA_SEN:
+                                config.algorithm = BASWANA_GUPTA_SENG;
+                                matcher->algorithm = new baswanaguptasen_dyn_matching(matcher->G, config);
+                                break;
+                        case DYNMATCH_NEIMAN_SOLOMON:
+                                config.algorithm = NEIMAN_SOLOMON;
+                                matcher->algorithm = new neimansolomon_dyn_matching(matcher->G, config);
+                                break;
+                        case DYNMATCH_NAIVE:
+                                config.algorithm = NAIVE;
+                                matcher->algorithm = new naive_dyn_matching(matcher->G, config);
+                                break;
+                        case DYNMATCH_DYNBLOSSOM:
+                                config.algorithm = DYNBLOSSOM;
+                                matcher->algorithm = new blossom_dyn_matching(matcher->G, config);
+                                break;
+                        case DYNMATCH_STATIC_BLOSSOM:
+                                config.algorithm = BLOSSOM;
+                                matcher->algorithm = new static_blossom(matcher->G, config);
+                                break;
+                }
+        } catch (...) {
+                dynmatch_destroy(matcher);
+                return NULL;
+        }
+
+        if( matcher->algorithm == NULL ) { // unknown algorithm
+                dynmatch_destroy(matcher);
+                return NULL;
+        }
+
+        return matcher;
+}
+
+void dynmatch_destroy(dynmatch_matcher * matcher) {
+        if( matcher == NULL ) return;
+
+        delete matcher->snapshot;
+        delete matcher->algorithm;
+        delete matcher->G;
+        delete matcher;
+}
+
+int dynmatch_insert_edge(dynmatch_matcher * matcher, unsigned u, unsigned v) {
+        int ret_code = check_edge(matcher, u, v);
+        if( ret_code != DYNMATCH_OK ) return ret_code;
+
+        random_functions::stream_scope scope(matcher->rng);
+        int changed = insert_edge(matcher, u, v);
+        if( changed ) publish(matcher);
+        return changed;
+}
+
+int dynmatch_remove_edge(dynmatch_matcher * matcher, unsigned u, unsigned v) {
+        int ret_code = check_edge(matcher, u, v);
+        if( ret_code != DYNMATCH_OK ) return ret_code;
+
+        random_functions::stream_scope scope(matcher->rng);
+        int changed = remove_edge(matcher, u, v);
+        if( changed ) publish(matcher);
+        return changed;
+}
+
+long dynmatch_apply_updates(dynmatch_matcher * matcher, const dynmatch_update * updates, size_t count) {
+        if( matcher == NULL ) return DYNMATCH_INVALID_HANDLE;
+
+        random_functions::stream_scope scope(matcher->rng);
+        long applied = 0;
+        for( size_t i = 0; i < count; i++) {
+                const dynmatch_update & update = updates[i];
+                if( check_edge(matcher, update.u, update.v) != DYNMATCH_OK ) continue;
+
+                if( update.insert ) {
+                        applied += insert_edge(matcher, update.u, update.v);
+                } else {
+                        applied += remove_edge(matcher, update.u, update.v);
+                }
+        }
+        publish(matcher);
+
+        return applied;
+}
+
+void dynmatch_postprocess(dynmatch_matcher * matcher) {
+        if( matcher == NULL ) return;
+
+        random_functions::stream_scope scope(matcher->rng);
+        matcher->algorithm->postprocessing();
+        publish(matcher);
+}
+
+int dynmatch_enable_concurrent_reads(dynmatch_matcher * matcher) {
+        if( matcher == NULL ) return DYNMATCH_INVALID_HANDLE;
+        if( matcher->snapshot != NULL ) return DYNMATCH_OK;
+
+        matcher->snapshot = new concurrent_matching(matcher->G->number_of_nodes());
+        matcher->snapshot->publish(matcher->algorithm->getM(), matcher->algorithm->getMSize());
+        matcher->algorithm->log_deltas(true);
+        return DYNMATCH_OK;
+}
+
+int dynmatch_enable_deltas(dynmatch_matcher * matcher) {
+        if( matcher == NULL ) return DYNMATCH_INVALID_HANDLE;
+
+        matcher->record_deltas = true;
+        matcher->algorithm->log_deltas(true);
+        return DYNMATCH_OK;
+}
+
+size_t dynmatch_drain_deltas(dynmatch_matcher * matcher, dynmatch_delta * deltas, size_t capacity) {
+        static_assert(sizeof(dynmatch_delta) == sizeof(MatchingDelta), "deltas are copied unchanged");
+        if( matcher == NULL ) return 0;
+
+        size_t count = std::min(capacity, matcher->pending.size() - matcher->pending_start);
+        std::copy(matcher->pending.begin() + matcher->pending_start,
+                  matcher->pending.begin() + matcher->pending_start + count,
+                  (MatchingDelta *) deltas);
+        matcher->pending_start += count;
+        if( matcher->pending_start == matcher->pending.size() ) {
+                matcher->pending.clear();
+                matcher->pending_start = 0;
+        }
+        return count;
+}
+
+unsigned dynmatch_number_of_nodes(const dynmatch_matcher * matcher) {
+        if( matcher == NULL ) return 0;
+        return matcher->G->number_of_nodes();
+}
+
+unsigned dynmatch_mate(const dynmatch_matcher * matcher, unsigned u) {
+        if( matcher == NULL || u >= matcher->G->number_of_nodes() ) return DYNMATCH_NOMATE;
+        if( matcher->snapshot != NULL ) return matcher->snapshot->mate(u);
+        return matcher->algorithm->getM()[u];
+}
+
+int dynmatch_is_matched(const dynmatch_matcher * matcher, unsigned u, unsigned v) {
+        if( check_edge(matcher, u, v) != DYNMATCH_OK ) return 0;
+        if( matcher->snapshot != NULL ) return matcher->snapshot->is_matched(u, v);
+
+        std::vector< NodeID > & matching = matcher->algorithm->getM();
+        return matching[u] == v && matching[v] == u;
+}
+
+unsigned dynmatch_matching_size(const dynmatch_matcher * matcher) {
+        if( matcher == NULL ) return 0;
+        if( matcher->snapshot != NULL ) return matcher->snapshot->size();
+        return matcher->algorithm->getMSize();
+}
@@ -0,0 +1,109 @@
+/******************************************************************************
+ * dynmatch_interface.h
+ *
+ * C interface of libdynmatch. A matcher owns its graph, its algorithm and its
+ * random stream, so any number of matchers can live in one process. A single
+ * matcher must not be used by several threads at the same time, unless
+ * concurrent reads are enabled (see dynmatch_enable_concurrent_reads).
+ *
+ *****************************************************************************/
+
+#ifndef DYNMATCH_INTERFACE_RYEM3K2C
+#define DYNMATCH_INTERFACE_RYEM3K2C
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define DYNMATCH_NOMATE 0xFFFFFFFFu
+
+/* return codes */
+#define DYNMATCH_OK              0
+#define DYNMATCH_INVALID_NODE   -1
+#define DYNMATCH_SELF_LOOP      -2
+#define DYNMATCH_INVALID_HANDLE -3
+
+typedef enum {
+        DYNMATCH_RANDOM_WALK,
+        DYNMATCH_BASWANA_GUPTA_SEN,
+        DYNMATCH_NEIMAN_SOLOMON,
+        DYNMATCH_NAIVE,
+        DYNMATCH_DYNBLOSSOM,
+        DYNMATCH_STATIC_BLOSSOM
+} dynmatch_algorithm;
+
+typedef struct {
+        dynmatch_algorithm algorithm;
+        int    seed;
+        /* limits the random walk / augmenting path length to 2/eps-1, 0 keeps the default */
+        double eps;
+        /* dynblossom only */
+        int    maintain_opt;
+        int    lazy;
+        /* baswanaguptasen only */
+        double bgs_factor;
+} dynmatch_options;
+
+typedef struct {
+        int      insert; /* 1 inserts the edge, 0 deletes it */
+        unsigned u;
+        unsigned v;
+} dynmatch_update;
+
+/* one change of the matching: {u,v} became matched (matched = 1) or unmatched (matched = 0) */
+typedef struct {
+        unsigned u;
+        unsigned v;
+        unsigned matched;
+} dynmatch_delta;
+
+typedef struct dynmatch_matcher dynmatch_matcher;
+
+/* fills in the defaults used by the dynmatch program */
+void dynmatch_default_options(dynmatch_options * options);
+
+/* creates a matcher on an empty graph with n nodes, returns NULL on failure */
+dynmatch_matcher * dynmatch_create(unsigned n, const dynmatch_options * options);
+
+void dynmatch_destroy(dynmatch_matcher * matcher);
+
+/* single updates, return 1 if the graph changed, 0 if the update was a no-op
+ * (edge already present / not present) and a negative error code otherwise */
+int dynmatch_insert_edge(dynmatch_matcher * matcher, unsigned u, unsigned v);
+int dynmatch_remove_edge(dynmatch_matcher * matcher, unsigned u, unsigned v);
+
+/* applies count updates in order and returns the number of updates that changed
+ * the graph; invalid updates are skipped. negative on an invalid handle */
+long dynmatch_apply_updates(dynmatch_matcher * matcher, const dynmatch_update * updates, size_t count);
+
+/* runs the final step of the algorithm, e.g. the actual solve of the static blossom algorithm */
+void dynmatch_postprocess(dynmatch_matcher * matcher);
+
+/* After this call the queries below may be issued from any number of threads
+ * while one thread keeps applying updates. They then answer from the matching
+ * as it was after the last completed update call (single update, batch or
+ * postprocess) and never block the updating thread. Returns DYNMATCH_OK. */
+int dynmatch_enable_concurrent_reads(dynmatch_matcher * matcher);
+
+/* starts recording the changes of the matching. Returns DYNMATCH_OK. */
+int dynmatch_enable_deltas(dynmatch_matcher * matcher);
+
+/* copies up to capacity of the changes recorded since the last drain into
+ * deltas, in the order they happened, and returns how many were copied. The
+ * rest is kept for the next call. Applying all changes in order to a copy of
+ * the matching yields the current matching. */
+size_t dynmatch_drain_deltas(dynmatch_matcher * matcher, dynmatch_delta * deltas, size_t capacity);
+
+/* queries */
+unsigned dynmatch_number_of_nodes(const dynmatch_matcher * matcher);
+unsigned dynmatch_mate(const dynmatch_matcher * matcher, unsigned u);
+int      dynmatch_is_matched(const dynmatch_matcher * matcher, unsigned u, unsigned v);
+unsigned dynmatch_matching_size(const dynmatch_matcher * matcher);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* end of include guard: DYNMATCH_INTERFACE_RYEM3K2C */
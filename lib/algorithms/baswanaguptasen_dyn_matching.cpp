@@ -19,8 +19,9 @@ baswanaguptasen_dyn_matching::~baswanaguptasen_dyn_matching() {
 }
 
 bool baswanaguptasen_dyn_matching::new_edge(NodeID source, NodeID target) {
-        G->new_edge(source, target);
+        bool added = G->new_edge(source, target);
         G->new_edge(target, source);
+        if( added ) count_new_edge(source, target);
         
         handle_addition(source, target);
 
@@ -28,8 +29,9 @@ bool baswanaguptasen_dyn_matching::new_edge(NodeID source, NodeID target) {
 }
 
 bool baswanaguptasen_dyn_matching::remove_edge(NodeID source, NodeID target) {
-        G->remove_edge(source, target);
+        bool removed = G->remove_edge(source, target);
         G->remove_edge(target, source);
+        if( removed ) count_removed_edge(source, target);
 
         handle_deletion(source, target);
 #ifndef NDEBUG
@@ -82,34 +84,82 @@ void baswanaguptasen_dyn_matching::handling_insertion (NodeID u, NodeID v) {
         }
 
         if (O[u].size() >= threshold) {
-                // (u,w) becomes unmatched, if w is the mate of u.
-                NodeID w = mate(u);
+                rise(u);
+        }
+}
 
-                if (is_matched(u, w)) {
-                        unmatch(u, w);
-                }
+// u is at level 0 but owns too many edges (violates invariant 2), so it rises to level 1
+void baswanaguptasen_dyn_matching::rise (NodeID u) {
+        // (u,w) becomes unmatched, if w is the mate of u.
+        NodeID w = mate(u);
 
-                // since u is at level 0, but violates invariant 2,
-                // it will rise to level 1. therefore we assign u as
-                // the only owner of all adjacent edges.
-                for (auto w_pair : O[u]) {
-                        O[w_pair].erase(u);
-                }
+        if (is_matched(u, w)) {
+                unmatch(u, w);
+        }
 
-                // call random settle to rise u to level 1
-                NodeID x = random_settle(u);
-                
-                // settle freed vertices
-                if (x != NOMATE) {
-                        naive_settle(x);
+        // since u is at level 0, but violates invariant 2,
+        // it will rise to level 1. therefore we assign u as
+        // the only owner of all adjacent edges.
+        for (auto w_pair : O[u]) {
+                O[w_pair].erase(u);
+        }
+
+        // call random settle to rise u to level 1
+        NodeID x = random_settle(u);
+        
+        // settle freed vertices
+        if (x != NOMATE) {
+                naive_settle(x);
+        }
+        
+        if (w != NOMATE) {
+                naive_settle(w);
+        }
+}
+
+void baswanaguptasen_dyn_matching::init_matching (const std::vector< NodeID > & initial_matching) {
+        dyn_matching::init_matching(initial_matching);
+
+        // all edges start at level 0 and are owned by both endpoints, then the
+        // vertices that own too many edges rise as if their last edge was inserted
+        for (NodeID u = 0; u < G->number_of_nodes(); ++u) {
+                set_level(u, 0);
+                O[u].clear();
+                O[u].resize(G->getNodeDegree(u));
+                for (EdgeID e = 0; e < G->getNodeDegree(u); ++e) {
+                        O[u].insert(G->getEdgeTarget(u, e));
                 }
-                
-                if (w != NOMATE) {
-                        naive_settle(w);
+        }
+
+        // a matched vertex rises together with its mate instead of taking a
+        // random owned neighbor, so no vertex of the static matching is freed
+        for (NodeID u = 0; u < G->number_of_nodes(); ++u) {
+                if (level(u) == 0 && O[u].size() >= threshold) {
+                        if (is_free(u)) {
+                                rise(u);
+                        } else {
+                                rise_with_mate(u);
+                        }
                 }
         }
 }
 
+// u and its mate w are at level 0, u owns too many edges. both rise to level 1
+// and own all their edges, as after random_settle(u) picked w
+void baswanaguptasen_dyn_matching::rise_with_mate (NodeID u) {
+        NodeID w = mate(u);
+
+        for (auto x : O[u]) {
+                O[x].erase(u);
+        }
+        for (auto x : O[w]) {
+                O[x].erase(w);
+        }
+
+        set_level(u, 1);
+        set_level(w, 1);
+}
+
 void baswanaguptasen_dyn_matching::handle_deletion (NodeID u, NodeID v) {
         // whatever happens afterwards, the edge (u,v) does not longer
         // exist in the graph, therefore all nodes have to forget the
@@ -200,7 +250,7 @@ void baswanaguptasen_dyn_matching::handling_deletion (NodeID u) {
 
 NodeID baswanaguptasen_dyn_matching::random_settle (NodeID u) {
         NodeID y = 0;
-        int tmp = random_functions::nextInt(0, O[u].size() - 1);
+        int tmp = random_functions::get_stream().bounded(O[u].size());
         for (auto x : O[u]) {
                 if (tmp-- == 0) {
                         y = x;
@@ -230,6 +280,8 @@ NodeID baswanaguptasen_dyn_matching::random_settle (NodeID u) {
 
 void baswanaguptasen_dyn_matching::naive_settle (NodeID u) {
         if (!is_free(u)) return;
+        // O[u] is a subset of the neighbors of u
+        if (m_count_free_neighbors && !free_neighbors.any(u)) return;
         
         for (auto x : O[u]) {
                 if (is_free(x)) {
@@ -296,3 +348,28 @@ void baswanaguptasen_dyn_matching::check_size_constraint() {
         
 }
 
+void baswanaguptasen_dyn_matching::checkpoint (checkpoint_writer & writer) {
+        dyn_matching::checkpoint(writer);
+        writer.write_vector(levels);
+
+        std::vector< NodeID > owned;
+        for (NodeID u = 0; u < O.size(); ++u) {
+                owned.assign(O[u].begin(), O[u].end());
+                writer.write_vector(owned);
+        }
+}
+
+void baswanaguptasen_dyn_matching::restore (checkpoint_reader & reader) {
+        dyn_matching::restore(reader);
+        reader.read_vector(levels);
+        levels.resize(G->number_of_nodes(), 0);
+
+        // the hash sets are rebuilt, so the iteration order and with it the
+        // random choices in random_settle may differ from the original run
+        for (NodeID u = 0; u < O.size(); ++u) {
+                uint64_t count = 0;
+                const NodeID * owned = reader.read_array< NodeID >(count);
+                O[u].clear();
+                O[u].insert(owned, owned + count);
+        }
+}
@@ -21,13 +21,17 @@
 #include "tools/random_functions.h"
 #include "tools/timer.h"
 
-class baswanaguptasen_dyn_matching : public dyn_matching {
+class baswanaguptasen_dyn_matching final : public dyn_matching {
         public:
                 baswanaguptasen_dyn_matching (dyn_graph_access* G, MatchConfig & config);
                 ~baswanaguptasen_dyn_matching ();
 
                 virtual bool new_edge(NodeID source, NodeID target);
                 virtual bool remove_edge(NodeID source, NodeID target);
+                virtual void init_matching (const std::vector< NodeID > & initial_matching);
+
+                virtual void checkpoint (checkpoint_writer & writer);
+                virtual void restore (checkpoint_reader & reader);
 
         protected:
                 // O_u denotes the set of edges owned by u. we save those
@@ -50,6 +54,8 @@ class baswanaguptasen_dyn_matching : public dyn_matching {
                 void handle_deletion (NodeID u, NodeID v);
                 void handling_deletion (NodeID u);
 
+                void rise (NodeID u);
+                void rise_with_mate (NodeID u);
                 NodeID random_settle (NodeID u);
                 void naive_settle (NodeID u);
 };
@@ -0,0 +1,205 @@
+/******************************************************************************
+ * bipartite_dyn_matching.cpp
+ *
+ *****************************************************************************/
+
+#include <algorithm>
+
+#include "bipartite_dyn_matching.h"
+
+bipartite_dyn_matching::bipartite_dyn_matching(dyn_graph_access* G, MatchConfig & match_config) : dyn_matching(G, match_config), side(match_config.sides),
+        deferred(match_config.dynblossom_speedheuristic ? G->number_of_nodes() : 0) {
+        pred.resize(G->number_of_nodes(), UNDEFINED_NODE);
+        visited.resize(G->number_of_nodes(), 0);
+        search_started.resize(G->number_of_nodes(), 0);
+        stamp     = 0;
+        iteration = 1;
+
+        if( config.maintain_opt ) enable_free_vertex_index(true);
+}
+
+bipartite_dyn_matching::~bipartite_dyn_matching() {
+
+}
+
+// lazy mode of dynblossom, see blossom_dyn_matching::new_edge
+bool bipartite_dyn_matching::lazy_skip(NodeID source, NodeID target) {
+        iteration++;
+        if( (search_started[source] != 0 && iteration - search_started[source] < G->number_of_edges()/2)
+         || (search_started[target] != 0 && iteration - search_started[target] < G->number_of_edges()/2) ) {
+                for( NodeID v : {source, target} ) {
+                        if( is_free(v) ) deferred.defer(v, G->getNodeDegree(v));
+                }
+                repair(config.dynblossom_repair_budget, config.dynblossom_repair_edges);
+                return true;
+        }
+        search_started[ source ] = iteration;
+        search_started[ target ] = iteration;
+        return false;
+}
+
+void bipartite_dyn_matching::next_stamp() {
+        if( ++stamp == 0 ) {
+                std::fill(visited.begin(), visited.end(), 0);
+                stamp = 1;
+        }
+}
+
+bool bipartite_dyn_matching::new_edge(NodeID source, NodeID target) {
+        bool added = G->new_edge(source, target);
+        G->new_edge(target, source);
+        if( added ) count_new_edge(source, target);
+        ASSERT_TRUE(side[source] != side[target]);
+
+        if( is_free(source) && is_free(target) ) {
+                rematch(source, target);
+                matching_size++;
+                return true;
+        }
+
+        if( config.dynblossom_speedheuristic && lazy_skip(source, target) ) return false;
+
+        if( config.maintain_opt && !is_free(source) && !is_free(target) ) {
+                maintain_opt_fallback(source);
+        } else {
+                if(is_free(source)) augment_path(source);
+                if(is_free(target)) augment_path(target);
+        }
+
+        return true;
+}
+
+bool bipartite_dyn_matching::remove_edge(NodeID source, NodeID target) {
+        bool removed = G->remove_edge(source, target);
+        G->remove_edge(target, source);
+        if( removed ) count_removed_edge(source, target);
+
+        if (is_matched(source, target)) {
+                release(source, target);
+                matching_size -= 1;
+        }
+
+        if( config.dynblossom_speedheuristic && lazy_skip(source, target) ) return false;
+
+        if(is_free(source)) augment_path(source);
+        if(is_free(target)) augment_path(target);
+
+        return true;
+}
+
+// an inserted edge between two matched nodes can only complete an augmenting
+// path between two free nodes of its component, the nearest of them is tried
+bool bipartite_dyn_matching::maintain_opt_fallback(NodeID source) {
+        // there is none with less than two free nodes with edges
+        if( free_vertices.size_with_edges() < 2 ) return false;
+
+        std::vector< NodeID > free_nodes;
+        next_stamp();
+        Q.clear(); Q.push_back(source);
+        visited[source] = stamp;
+
+        for( size_t head = 0; head < Q.size() && free_nodes.empty(); head++) {
+                NodeID node = Q[head];
+                forall_out_edges((*G), e, node) {
+                        NodeID target = G->getEdgeTarget(node,e);
+                        if( visited[target] != stamp ) {
+                                visited[target] = stamp;
+                                Q.push_back(target);
+                                if( is_free(target) ) free_nodes.push_back(target);
+                        }
+                } endfor
+        }
+
+        NodeID cur_matching_size = matching_size;
+        for( unsigned i = 0; i < free_nodes.size() && cur_matching_size == matching_size; i++) {
+                augment_path(free_nodes[i]);
+        }
+
+        return cur_matching_size != matching_size;
+}
+
+NodeID bipartite_dyn_matching::getMSize () {
+        return matching_size;
+}
+
+// as in blossom_dyn_matching
+void bipartite_dyn_matching::repair( size_t searches, unsigned long long budget ) {
+        deferred.repair(searches, [&] (NodeID v) {
+                if( !is_free(v) ) return false;
+                augment_path(v, budget);
+                return true;
+        });
+}
+
+void bipartite_dyn_matching::retry () {
+        repair(deferred.size(), std::numeric_limits< unsigned long long >::max());
+}
+
+void bipartite_dyn_matching::postprocessing () {
+        if( config.dynblossom_lazy_drain ) retry();
+}
+
+void bipartite_dyn_matching::init_matching (const std::vector< NodeID > & initial_matching) {
+        dyn_matching::init_matching(initial_matching);
+        matching_size /= 2;
+        deferred.clear();
+}
+
+void bipartite_dyn_matching::checkpoint (checkpoint_writer & writer) {
+        dyn_matching::checkpoint(writer);
+        writer.write_vector(search_started);
+        writer.write(iteration);
+        deferred.checkpoint(writer);
+}
+
+void bipartite_dyn_matching::restore (checkpoint_reader & reader) {
+        dyn_matching::restore(reader);
+        reader.read_vector(search_started);
+        reader.read(iteration);
+        deferred.restore(reader);
+        search_started.resize(G->number_of_nodes(), 0);
+}
+
+void bipartite_dyn_matching::augment_path(NodeID node, unsigned long long budget) {
+        if( matching[node] != NOMATE ) return;
+
+        // Q holds the nodes on the side of node, level by level. paths have
+        // length at most 2/eps-1 as in blossom_dyn_matching
+        next_stamp();
+        Q.clear(); Q.push_back(node);
+        size_t level_end = Q.size();
+        NodeID cur_level = 0;
+
+        for( size_t head = 0; head < Q.size(); head++) {
+                if( head == level_end ) {
+                        if( cur_level >= (NodeID) config.rw_max_length ) return;
+                        cur_level += 2;
+                        level_end = Q.size();
+                }
+
+                NodeID v = Q[head];
+                if( budget == 0 ) return;
+                budget -= std::min(budget, (unsigned long long) G->getNodeDegree(v));
+
+                forall_out_edges((*G), e, v) {
+                        NodeID w = G->getEdgeTarget(v, e);
+                        if( visited[w] == stamp ) continue;
+                        ASSERT_TRUE(side[w] != side[node]);
+
+                        visited[w] = stamp;
+                        pred[w]    = v;
+                        if( is_free(w) ) {
+                                // flip the path w v .. node
+                                while( w != NOMATE ) {
+                                        NodeID x    = pred[w];
+                                        NodeID next = matching[x];
+                                        rematch(x, w);
+                                        w = next;
+                                }
+                                matching_size++;
+                                return;
+                        }
+                        Q.push_back(matching[w]);
+                } endfor
+        }
+}
@@ -0,0 +1,63 @@
+/******************************************************************************
+ * bipartite_dyn_matching.h
+ *
+ * dynblossom for bipartite graphs. The searches are alternating BFS from a
+ * free node; without odd cycles there are no blossoms, so a node of the
+ * other side is visited at most once and no partition, bridges or
+ * path marks are kept. Options (eps, lazy with its repair queue,
+ * maintain_opt) are those of blossom_dyn_matching.
+ *
+ *****************************************************************************/
+
+#ifndef BIPARTITE_DYN_MATCHING_H
+#define BIPARTITE_DYN_MATCHING_H
+
+#include <limits>
+#include <vector>
+
+#include "dyn_matching.h"
+#include "data_structure/deferred_searches.h"
+
+class bipartite_dyn_matching final : public dyn_matching {
+        public:
+                // config.sides holds the side of every node
+                bipartite_dyn_matching (dyn_graph_access* G, MatchConfig & config); 
+                ~bipartite_dyn_matching (); 
+
+                virtual bool new_edge(NodeID source, NodeID target);
+                virtual bool remove_edge(NodeID source, NodeID target);
+                virtual NodeID getMSize ();
+                virtual void init_matching (const std::vector< NodeID > & initial_matching);
+                // search from all deferred free nodes, postprocessing only with
+                // --dynblossom_lazy_drain
+                virtual void retry ();
+                virtual void postprocessing ();
+
+                virtual void checkpoint (checkpoint_writer & writer);
+                virtual void restore (checkpoint_reader & reader);
+
+                void augment_path(NodeID source, unsigned long long budget = std::numeric_limits< unsigned long long >::max()); 
+                bool maintain_opt_fallback(NodeID source);
+
+        private:
+                // in lazy mode, true if the update is skipped. its free endpoints
+                // are deferred
+                bool lazy_skip(NodeID source, NodeID target);
+                void repair( size_t searches, unsigned long long budget );
+                void next_stamp();
+
+                const std::vector< NodeID > & side;
+
+                // pred[w] is the node the search came from to w on the other side,
+                // valid while visited[w] == stamp
+                std::vector< NodeID > pred;
+                std::vector< unsigned > visited;
+                unsigned stamp;
+
+                std::vector< NodeID > Q;
+                std::vector< NodeID > search_started;
+                int iteration;
+                deferred_searches deferred;
+};
+
+#endif 
@@ -3,17 +3,14 @@
 
 #include <algorithm>
 #include "blossom_dyn_matching.h"
-#include "node_partition.h"
+#include "blossom_base.h"
 
-blossom_dyn_matching::blossom_dyn_matching(dyn_graph_access* G, MatchConfig & match_config) : dyn_matching(G, match_config) {
-        label.resize(G->number_of_nodes()); 
-        pred.resize(G->number_of_nodes()); 
-        path1.resize(G->number_of_nodes());
-        path2.resize(G->number_of_nodes());
+blossom_dyn_matching::blossom_dyn_matching(dyn_graph_access* G, MatchConfig & match_config) : dyn_matching(G, match_config),
+        deferred(match_config.dynblossom_speedheuristic ? G->number_of_nodes() : 0) {
+        state.resize(G->number_of_nodes()); 
         source_bridge.resize(G->number_of_nodes());
         target_bridge.resize(G->number_of_nodes());
         search_started.resize(G->number_of_nodes());
-        fallback_visited.resize(G->number_of_nodes());
 
         strue = 0;
         base.init(G);
@@ -24,15 +21,28 @@ blossom_dyn_matching::blossom_dyn_matching(dyn_graph_access* G, MatchConfig & ma
         // {base(v) | v \in V} is the node set of G'
         // and edge {v,w} represents an edge {base(v), base(w)} in G'
         forall_nodes((*G), node) {
-                label[node] = EVEN; // can be EVEN, ODD, or UNLABELED
-                pred[node]  = UNDEFINED_NODE;
-                path1[node] = 0;
-                path2[node] = 0;
+                state[node].label = EVEN; // can be EVEN, ODD, or UNLABELED
                 source_bridge[node] = UNDEFINED_NODE;
                 target_bridge[node] = UNDEFINED_NODE;
                 search_started[node] = 0;
-                fallback_visited[node] = false;
         } endfor
+
+        Q.reserve(G->number_of_nodes());
+        T.reserve(G->number_of_nodes());
+        bfs_queue.reserve(G->number_of_nodes());
+
+        local_epoch = 0;
+        if( config.maintain_opt && config.dynblossom_local_budget > 0 ) {
+                local_stamp.assign(G->number_of_nodes(), 0);
+        }
+
+        if( config.dynblossom_reuse_forest ) {
+                forest_root.assign(G->number_of_nodes(), UNDEFINED_NODE);
+                forest_next.assign(G->number_of_nodes(), UNDEFINED_NODE);
+                forest_outer.assign(G->number_of_nodes(), false);
+        }
+
+        if( config.maintain_opt ) enable_free_vertex_index(true);
 }
 
 blossom_dyn_matching::~blossom_dyn_matching() {
@@ -40,14 +50,19 @@ blossom_dyn_matching::~blossom_dyn_matching() {
 }
 
 bool blossom_dyn_matching::new_edge(NodeID source, NodeID target) {
-        G->new_edge(source, target);
+        bool added = G->new_edge(source, target);
         G->new_edge(target, source);
+        if( added ) count_new_edge(source, target);
+
+        // an edge at an outer node of a kept tree can close an augmenting path
+        // through the tree, one at an inner node can not
+        if( in_forest(source) && forest_outer[source] ) drop_tree(source);
+        if( in_forest(target) && forest_outer[target] ) drop_tree(target);
 
         if( is_free(source) && is_free(target) ) {
-                matching[source] = target;
-                matching[target] = source;
-                label[source] = UNLABELED;
-                label[target] = UNLABELED;
+                rematch(source, target);
+                state[source].label = UNLABELED;
+                state[target].label = UNLABELED;
 
                 matching_size++;
                 return true;
@@ -55,15 +70,26 @@ bool blossom_dyn_matching::new_edge(NodeID source, NodeID target) {
 
         if( config.dynblossom_speedheuristic || config.dynblossom_weakspeedheuristic) {
                 iteration++;
-                if( search_started[source] != 0 && iteration - search_started[source] < G->number_of_edges()/2 ) return false;
-                if( search_started[target] != 0 && iteration - search_started[target] < G->number_of_edges()/2 ) return false;
+                if( (search_started[source] != 0 && iteration - search_started[source] < G->number_of_edges()/2) 
+                 || (search_started[target] != 0 && iteration - search_started[target] < G->number_of_edges()/2)) {
+                        defer(source);
+                        defer(target);
+                        repair(config.dynblossom_repair_budget, config.dynblossom_repair_edges);
+                        return false;
+                }
                 search_started[ source ] = iteration;
                 search_started[ target ] = iteration;
         }
 
         if( config.maintain_opt ) {
+                // a duplicate of a matching edge adds no path. the local search
+                // must not start from it, both sides would flip through u and v
+                if( is_matched(source, target) ) return true;
+
                 if(!is_free(source) && !is_free(target)) {
-                        maintain_opt_fallback(source, target);                       
+                        if( local_stamp.empty() || local_augment(source, target) == LOCAL_UNKNOWN ) {
+                                maintain_opt_fallback(source, target);                       
+                        }
                 } else {
                         if(is_free(source)) augment_path(source);
                         if(is_free(target)) augment_path(target);
@@ -79,23 +105,32 @@ bool blossom_dyn_matching::new_edge(NodeID source, NodeID target) {
 
 
 bool blossom_dyn_matching::remove_edge(NodeID source, NodeID target) {
-        G->remove_edge(source, target);
+        bool removed = G->remove_edge(source, target);
         G->remove_edge(target, source);
+        if( removed ) count_removed_edge(source, target);
+
+        if( in_forest(source) && forest_root[source] == forest_root[target] ) {
+                drop_tree(source);
+        }
 
         if (is_matched(source, target)) {
-                matching[source] = NOMATE;
-                matching[target] = NOMATE;
+                release(source, target);
 
                 matching_size -= 1;
 
-                label[source] = EVEN;
-                label[target] = EVEN;
+                state[source].label = EVEN;
+                state[target].label = EVEN;
         }
 
         if( config.dynblossom_speedheuristic ) {
                 iteration++;
-                if( search_started[source] != 0 && iteration - search_started[source] < G->number_of_edges()/2 ) return false;
-                if( search_started[target] != 0 && iteration - search_started[target] < G->number_of_edges()/2 ) return false;
+                if( (search_started[source] != 0 && iteration - search_started[source] < G->number_of_edges()/2) 
+                 || (search_started[target] != 0 && iteration - search_started[target] < G->number_of_edges()/2)) {
+                        defer(source);
+                        defer(target);
+                        repair(config.dynblossom_repair_budget, config.dynblossom_repair_edges);
+                        return false;
+                }
                 search_started[ source ] = iteration;
                 search_started[ target ] = iteration;
         }
@@ -120,25 +155,24 @@ bool blossom_dyn_matching::remove_edge(NodeID source, NodeID target) {
         return true;
 }
 bool blossom_dyn_matching::maintain_opt_fallback(NodeID source, NodeID target) {
-        // perform BFS to find all reachable free nodes 
-        std::vector< NodeID > touched_nodes;
-        std::vector< NodeID > free_nodes;
+        // an augmenting path needs two free ends with edges
+        if( free_vertices.size_with_edges() < 2 ) return true;
 
-        std::queue< NodeID > bfsqueue;
-        bfsqueue.push(source);
-        fallback_visited[source] = true;
-        touched_nodes.push_back(source);
+        // perform BFS to find all reachable free nodes, the queue
+        // holds all touched nodes
+        free_nodes.clear();
+        bfs_queue.clear();
+        bfs_queue.push_back(source);
+        state[source].visited = true;
 
-        while(!bfsqueue.empty() && free_nodes.size() == 0) {
-                NodeID node = bfsqueue.front();
-                bfsqueue.pop(); 
+        for( size_t head = 0; head < bfs_queue.size() && free_nodes.size() == 0; head++) {
+                NodeID node = bfs_queue[head];
 
                 forall_out_edges((*G), e, node) {
                         NodeID target = G->getEdgeTarget(node,e);
-                        if(!fallback_visited[target]) {
-                                fallback_visited[target] = true;
-                                bfsqueue.push(target);
-                                touched_nodes.push_back(target);
+                        if(!state[target].visited) {
+                                state[target].visited = true;
+                                bfs_queue.push_back(target);
                                 if( matching[target] == NOMATE ) {
                                         free_nodes.push_back(target);
                                 }
@@ -152,18 +186,248 @@ bool blossom_dyn_matching::maintain_opt_fallback(NodeID source, NodeID target) {
                 if(cur_matching_size != matching_size) { break;} // augmented a path
 
         }
-        for( unsigned i = 0; i < touched_nodes.size(); i++) {
-                fallback_visited[touched_nodes[i]] = false;
+        for( unsigned i = 0; i < bfs_queue.size(); i++) {
+                state[bfs_queue[i]].visited = false;
         }
 
         return true;
 }
 
+// an augmenting path through {u,v} reads a ... mate(u) u v mate(v) ... b, so
+// from each end we grow the alternating paths that leave it by its matching
+// edge. even nodes are u, v and the ones entered by a non matching edge, odd
+// ones are their mates. a side that finds a free node stops, the sides never
+// share a node so two found paths form an augmenting path. if a side runs out
+// of nodes without ever meeting the other side or an odd cycle, its paths are
+// all there are and none ends free, so there is no augmenting path through
+// {u,v}. everything else is left to the global search.
+blossom_dyn_matching::local_result blossom_dyn_matching::local_augment( NodeID u, NodeID v ) {
+        local_epoch++;
+        if( local_epoch == (1u << 30) ) {
+                std::fill(local_stamp.begin(), local_stamp.end(), 0);
+                local_epoch = 1;
+        }
+        const unsigned stamp = local_epoch << 2;
+
+        NodeID end[2] = {u, v};
+        for( int side = 0; side < 2; side++) {
+                local_stamp[end[side]]           = stamp | (side << 1);
+                local_stamp[matching[end[side]]] = stamp | (side << 1) | 1;
+                local_queue[side].clear();
+                local_queue[side].push_back(matching[end[side]]);
+                local_head[side]  = 0;
+                local_found[side] = UNDEFINED_NODE;
+                local_clean[side] = true;
+        }
+
+        unsigned long long budget = config.dynblossom_local_budget;
+        bool active[2] = {true, true};
+        while( active[0] || active[1] ) {
+                for( int side = 0; side < 2; side++) {
+                        if( !active[side] ) continue;
+                        if( local_head[side] == local_queue[side].size() ) {
+                                if( local_clean[side] ) return LOCAL_NO_PATH;
+                                active[side] = false;
+                                continue;
+                        }
+                        NodeID o = local_queue[side][local_head[side]++];
+                        if( local_expand(side, o, budget) ) active[side] = false;
+                }
+                // neither side can prove anything any more
+                if( budget == 0 || (!local_clean[0] && !local_clean[1]) ) break;
+        }
+        if( local_found[0] == UNDEFINED_NODE || local_found[1] == UNDEFINED_NODE ) return LOCAL_UNKNOWN;
+
+        // kept trees that contain a node of the path lose their matching
+        if( !forest_root.empty() ) {
+                for( int side = 0; side < 2; side++) {
+                        NodeID x = local_found[side];
+                        while( x != end[side] ) {
+                                if( in_forest(x) ) drop_tree(x);
+                                x = state[x].pred;
+                                if( in_forest(x) ) drop_tree(x);
+                                x = matching[x];
+                        }
+                        if( in_forest(x) ) drop_tree(x);
+                }
+        }
+
+        local_flip(local_found[0], u);
+        local_flip(local_found[1], v);
+        rematch(u, v);
+        state[local_found[0]].label = UNLABELED;
+        state[local_found[1]].label = UNLABELED;
+        matching_size++;
+
+        return LOCAL_AUGMENTED;
+}
+
+// scans the non matching edges of the odd node o, true if the side found a
+// free node
+bool blossom_dyn_matching::local_expand( int side, NodeID o, unsigned long long & budget ) {
+        const unsigned stamp = local_epoch << 2;
+        forall_out_edges((*G), e, o) {
+                if( budget == 0 ) return false;
+                budget--;
+
+                NodeID y = G->getEdgeTarget(o, e);
+                if( y == matching[o] ) continue;
+                if( (local_stamp[y] >> 2) == local_epoch ) {
+                        // an odd cycle or the other side, the side proves nothing
+                        if( local_stamp[y] != (stamp | (side << 1)) ) local_clean[side] = false;
+                        continue;
+                }
+
+                local_stamp[y] = stamp | (side << 1);
+                state[y].pred = o;
+                if( matching[y] == NOMATE ) {
+                        local_found[side] = y;
+                        return true;
+                }
+
+                NodeID x = matching[y];
+                if( (local_stamp[x] >> 2) == local_epoch ) {
+                        local_clean[side] = false;
+                        continue;
+                }
+                local_stamp[x] = stamp | (side << 1) | 1;
+                local_queue[side].push_back(x);
+        } endfor
+        return false;
+}
+
+// shifts the matching along the path from free_node back to end, which is
+// left free
+void blossom_dyn_matching::local_flip( NodeID free_node, NodeID end ) {
+        NodeID y = free_node;
+        while( true ) {
+                NodeID o    = state[y].pred;
+                NodeID next = matching[o];
+                rematch(o, y);
+                if( next == end ) break;
+                y = next;
+        }
+}
+
+void blossom_dyn_matching::defer( NodeID v ) {
+        if( is_free(v) ) deferred.defer(v, G->getNodeDegree(v));
+}
+
+// nodes that got matched in the meantime are dropped without a search. the
+// queue hands out the nodes of highest degree first, so each search is
+// bounded by the edges it scans, a length limit alone would not bound it
+void blossom_dyn_matching::repair( size_t searches, unsigned long long budget ) {
+        deferred.repair(searches, [&] (NodeID v) {
+                if( !is_free(v) ) return false;
+                augment_path(v, budget);
+                return true;
+        });
+}
+
+void blossom_dyn_matching::retry () {
+        repair(deferred.size(), std::numeric_limits< unsigned long long >::max());
+}
+
+void blossom_dyn_matching::postprocessing () {
+        if( config.dynblossom_lazy_drain ) retry();
+}
+
 NodeID  blossom_dyn_matching::getMSize () {
         return matching_size;
 }
 
-void blossom_dyn_matching::augment_path(NodeID node) {
+void blossom_dyn_matching::init_matching (const std::vector< NodeID > & initial_matching) {
+        dyn_matching::init_matching(initial_matching);
+        matching_size /= 2;
+
+        forall_nodes((*G), node) {
+                state[node].label = is_free(node) ? EVEN : UNLABELED;
+        } endfor
+        std::fill(forest_root.begin(), forest_root.end(), UNDEFINED_NODE);
+        deferred.clear();
+}
+
+// between two updates all blossoms are expanded and of the node records only the
+// labels are read before a search writes them, so the records, the kept trees
+// and the lazy mode counters and queue are all that is left to save
+void blossom_dyn_matching::checkpoint (checkpoint_writer & writer) {
+        dyn_matching::checkpoint(writer);
+        writer.write_vector(state);
+        writer.write_vector(search_started);
+        writer.write(iteration);
+        writer.write(strue);
+        writer.write_vector(forest_root);
+        writer.write_vector(forest_next);
+        writer.write_vector(forest_outer);
+        deferred.checkpoint(writer);
+}
+
+void blossom_dyn_matching::restore (checkpoint_reader & reader) {
+        dyn_matching::restore(reader);
+        reader.read_vector(state);
+        reader.read_vector(search_started);
+        reader.read(iteration);
+        reader.read(strue);
+        reader.read_vector(forest_root);
+        reader.read_vector(forest_next);
+        reader.read_vector(forest_outer);
+        deferred.restore(reader);
+        state.resize(G->number_of_nodes());
+        search_started.resize(G->number_of_nodes(), 0);
+        if( config.dynblossom_reuse_forest && forest_root.empty() ) {
+                forest_root.assign(G->number_of_nodes(), UNDEFINED_NODE);
+                forest_next.assign(G->number_of_nodes(), UNDEFINED_NODE);
+                forest_outer.assign(G->number_of_nodes(), false);
+        }
+}
+
+// T and Q of the search from root, the labels stay as they are so that later
+// searches treat the inner nodes as odd and never reach the outer ones. the
+// tree joins the group of every kept tree it skipped over, a group is only
+// dropped as a whole
+void blossom_dyn_matching::keep_tree( NodeID root ) {
+        NodeID group = forest_touched.empty() ? root : forest_touched[0];
+        for( unsigned i = 0; i < forest_touched.size(); i++) {
+                NodeID other = forest_touched[i];
+                if( other == group || forest_root[other] == group ) continue;
+
+                // relabel the other group and splice it in behind the head
+                NodeID tail = other;
+                for( NodeID x = other; x != UNDEFINED_NODE; x = forest_next[x]) {
+                        forest_root[x] = group;
+                        tail = x;
+                }
+                forest_next[tail]  = forest_next[group];
+                forest_next[group] = other;
+        }
+
+        for( unsigned i = 0; i < T.size(); i++) {
+                forest_root[T[i]]  = group;
+                forest_next[T[i]]  = i + 1 < T.size() ? T[i+1] : UNDEFINED_NODE;
+                forest_outer[T[i]] = false;
+        }
+        if( group != root ) {
+                forest_next[T.back()] = forest_next[group];
+                forest_next[group]    = root;
+        }
+
+        NodeID LEVEL = G->number_of_nodes();
+        for( unsigned i = 0; i < Q.size(); i++) {
+                if( Q[i] != LEVEL ) forest_outer[Q[i]] = true;
+        }
+}
+
+void blossom_dyn_matching::drop_tree( NodeID v ) {
+        NodeID x = forest_root[v];
+        while( x != UNDEFINED_NODE ) {
+                NodeID next = forest_next[x];
+                state[x].label = matching[x] == NOMATE ? EVEN : UNLABELED;
+                forest_root[x] = UNDEFINED_NODE;
+                x = next;
+        }
+}
+
+void blossom_dyn_matching::augment_path(NodeID node, unsigned long long budget) {
         //for( unsigned i = 0; i < reset_st_bridge.size(); i++) {
         //source_bridge[reset_st_bridge[i]] = UNDEFINED_NODE;
         //target_bridge[reset_st_bridge[i]] = UNDEFINED_NODE;
@@ -172,80 +436,85 @@ void blossom_dyn_matching::augment_path(NodeID node) {
         //reset_st_bridge.resize(0);
 
         if( matching[node] != NOMATE) return;
+        // the root of a kept tree, the search would fail again
+        if( in_forest(node) ) return;
 
         NodeID LEVEL = G->number_of_nodes();
-        std::queue< NodeID > Q; Q.push(node); 
-        Q.push(LEVEL);
-        std::vector< NodeID > T; T.push_back(node);
+        Q.clear(); Q.push_back(node); 
+        Q.push_back(LEVEL);
+        T.clear(); T.push_back(node);
+        forest_touched.clear();
 
         bool breakthrough = false;
-        int count = 0; 
+        bool limited = false;
         NodeID cur_level = 0;
-        while( !breakthrough && !Q.empty()) { // grow tree rooted at node
-                count++;
-                NodeID v = Q.front(); Q.pop();
+        size_t head = 0;
+        while( !breakthrough && head < Q.size()) { // grow tree rooted at node
+                NodeID v = Q[head++];
                 if(  v == LEVEL ) {
-                        if(cur_level >= (NodeID) config.rw_max_length) break;
-                        if( Q.empty() ) break;
+                        if(cur_level >= (NodeID) config.rw_max_length) { limited = true; break; }
+                        if( head == Q.size() ) break;
 
-                        v = Q.front(); Q.pop();
+                        v = Q[head++];
                         cur_level += 2;
-                        Q.push(LEVEL);
+                        Q.push_back(LEVEL);
                 }
+                if( budget == 0 ) { limited = true; break; }
+                budget -= std::min(budget, (unsigned long long) G->getNodeDegree(v));
                 // explore edges out of v
                 // assume v is even node
                 forall_out_edges((*G), e, v) {
                         NodeID w = G->getEdgeTarget(v, e);
-                        if( base(v) == base(w) || label[base(w)] == ODD) 
+                        if( base(v) == base(w) || state[base(w)].label == ODD) {
+                                // an inner node of a kept tree, the tree of this
+                                // search is only valid as long as that one is
+                                if( in_forest(w) ) forest_touched.push_back(forest_root[w]);
                                 continue; // nothing todo
-                        if( label[w] == UNLABELED ) {
-                                label[w] = ODD; 
+                        }
+                        if( state[w].label == UNLABELED ) {
+                                state[w].label = ODD; 
                                 T.push_back(w);
 
-                                pred[w] = v;
-                                label[matching[w]] = EVEN; 
+                                state[w].pred = v;
+                                state[matching[w]].label = EVEN; 
 
                                 T.push_back(matching[w]);
-                                Q.push(matching[w]);
+                                Q.push_back(matching[w]);
                         } else { // base(w) is EVEN
                                 NodeID hv = base(v);
                                 NodeID hw = base(w);
 
-                                strue++;
-                                path1[hv] = strue;
-                                path2[hw] = strue;
+                                next_path_stamp(state, strue);
+                                state[hv].mark_path1(strue);
+                                state[hw].mark_path2(strue);
 
-                                while( (path1[hw] != strue && path2[hv] != strue) && (matching[hv] != NOMATE || matching[hw] != NOMATE) ) {
+                                while( (!state[hw].on_path1(strue) && !state[hv].on_path2(strue)) && (matching[hv] != NOMATE || matching[hw] != NOMATE) ) {
                                         if( matching[hv] != NOMATE ) {
-                                                hv = base( pred[ matching[hv] ] );
-                                                path1[hv] = strue;
+                                                hv = base( state[ matching[hv] ].pred );
+                                                state[hv].mark_path1(strue);
                                         }
 
                                         if( matching[hw] != NOMATE ) {
-                                                hw = base( pred[ matching[hw] ] );
-                                                path2[hw] = strue;
+                                                hw = base( state[ matching[hw] ].pred );
+                                                state[hw].mark_path2(strue);
                                         }
                                 }
 
-                                if( path1[ hw ] == strue || path2[ hv ] == strue ) {
+                                if( state[ hw ].on_path1(strue) || state[ hv ].on_path2(strue) ) {
                                         // shrink blossom
-                                        NodeID b = (path1[hw] == strue) ? hw : hv; //base
-                                        shrink_path(b,v,w, base, source_bridge, target_bridge, Q);
-                                        shrink_path(b,w,v, base, source_bridge, target_bridge, Q);
+                                        NodeID b = state[hw].on_path1(strue) ? hw : hv; //base
+                                        shrink_path(b,v,w);
+                                        shrink_path(b,w,v);
                                 } else {
                                         // augment path
-                                        std::vector< NodeID > P_int;
-                                        find_path( P_int, v, hv, source_bridge, target_bridge);
-
-                                        std::vector< NodeID > P;
+                                        P.clear();
                                         P.push_back(w);
-                                        P.insert(P.end(), P_int.begin(), P_int.end()); 
+                                        find_path( P, v, hv );
                                         while( !P.empty() ) {
                                                 NodeID a = P.back(); P.pop_back();
                                                 NodeID b = P.back(); P.pop_back();
 
-                                                matching[a] = b;
-                                                matching[b] = a;
+                                                rematch(a, b);
                                         }
                                         T.push_back(w);
                                         breakthrough = true;
@@ -256,58 +525,69 @@ void blossom_dyn_matching::augment_path(NodeID node) {
                         }        
                 } endfor
         }
-        for( unsigned i = 0; i < T.size(); i++) {
-                if( matching[T[i]] == NOMATE ) {
-                        label[T[i]] = EVEN;
-                } else {
-                        label[T[i]] = UNLABELED;
+        if( !breakthrough && !limited && !forest_root.empty() ) {
+                // no augmenting path can pass through the tree until an update
+                // changes it
+                keep_tree(node);
+        } else {
+                for( unsigned i = 0; i < T.size(); i++) {
+                        if( matching[T[i]] == NOMATE ) {
+                                state[T[i]].label = EVEN;
+                        } else {
+                                state[T[i]].label = UNLABELED;
+                        }
                 }
         }
-        base.split(T);
-        //std::cout <<  "run for " <<  count  << std::endl;
+        base.reset();
 }
 
-void blossom_dyn_matching::shrink_path( NodeID b, NodeID v, NodeID w, node_partition & base, std::vector< NodeID > & source_bridge, std::vector< NodeID > & target_bridge, std::queue< NodeID > & Q) {
+void blossom_dyn_matching::shrink_path( NodeID b, NodeID v, NodeID w ) {
         // Note we are working in x prime (so node can be blossoms by itself
         NodeID x = base(v);
         while(x != b) {
                 base.union_blocks(x,b);
-                //base.union_blocks_withreset(x,b);
                 x = matching[x];
 
                 base.union_blocks(x,b);
-                //base.union_blocks_withreset(x,b);
                 base.make_rep(b);
 
-                Q.push(x);
+                Q.push_back(x);
 
                 source_bridge[x] = v; target_bridge[x] = w;
-                x = base( pred[x] );
-                //reset_st_bridge.push_back(x);
+                x = base( state[x].pred );
         }
 }
 
+// iterative version of the recursive definition
+//   path(x, y) = x                                              if x = y
+//              = x, mate(x), path(pred(mate(x)), y)             if x is EVEN
+//              = x, reverse(path(source_bridge(x), mate(x))),
+//                   path(target_bridge(x), y)                   if x is ODD
+// the pending parts are kept on a stack, so blossoms nested arbitrarily deep
+// need neither recursion nor temporary vectors
+void blossom_dyn_matching::find_path( std::vector< NodeID > & P, NodeID x, NodeID y ) {
+        path_tasks.clear();
+        path_tasks.push_back({x, y, 0, false});
+
+        while( !path_tasks.empty() ) {
+                path_task task = path_tasks.back(); path_tasks.pop_back();
+                if( task.reverse ) {
+                        std::reverse(P.begin() + task.start, P.end());
+                        continue;
+                }
 
-void blossom_dyn_matching::find_path( std::vector< NodeID > & P, NodeID x, NodeID y, std::vector< NodeID > & source_bridge, std::vector< NodeID > & target_bridge) {
-        if ( x == y ) {
-                P.push_back(x);
-                return;
-        }
+                NodeID cur = task.x;
+                while( cur != task.y && state[cur].label == EVEN ) {
+                        P.push_back(cur);
+                        P.push_back(matching[cur]);
+                        cur = state[matching[cur]].pred;
+                }
+                P.push_back(cur);
 
-        if( label[x] == EVEN ) {
-                P.push_back(x);
-                P.push_back(matching[x]);
-                find_path(P, pred[matching[x]], y, source_bridge, target_bridge);
-                return;
-        } else { // x is ODD
-                P.push_back(x);
-
-                std::vector< NodeID > P2; 
-                find_path( P2, source_bridge[x], matching[x], source_bridge, target_bridge);
-
-                std::reverse(P2.begin(), P2.end());
-                P.insert(P.end(), P2.begin(), P2.end()); // concatenate P and P2
-                find_path( P, target_bridge[x], y, source_bridge, target_bridge);
-                return;
+                if( cur != task.y ) { // cur is ODD
+                        path_tasks.push_back({target_bridge[cur], task.y, 0, false});
+                        path_tasks.push_back({0, 0, P.size(), true});
+                        path_tasks.push_back({source_bridge[cur], matching[cur], 0, false});
+                }
         }
 }
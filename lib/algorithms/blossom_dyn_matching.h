@@ -10,6 +10,7 @@
 #include <bitset>
 #include <cassert>
 #include <iostream>
+#include <limits>
 #include <vector>
 #include <random>
 #include <chrono>
@@ -19,9 +20,11 @@
 #include "tools/timer.h"
 #include "data_structure/union_find.h"
 #include "tools/misc.h"
-#include "node_partition.h"
+#include "data_structure/deferred_searches.h"
+#include "blossom_base.h"
+#include "blossom_node.h"
 
-class blossom_dyn_matching : public dyn_matching {
+class blossom_dyn_matching final : public dyn_matching {
         public:
                 blossom_dyn_matching (dyn_graph_access* G, MatchConfig & config); 
                 ~blossom_dyn_matching (); 
@@ -29,26 +32,88 @@ class blossom_dyn_matching : public dyn_matching {
                 virtual bool new_edge(NodeID source, NodeID target);
                 virtual bool remove_edge(NodeID source, NodeID target);
                 virtual NodeID getMSize ();
+                virtual void init_matching (const std::vector< NodeID > & initial_matching);
+                // search from all deferred free nodes, postprocessing only with
+                // --dynblossom_lazy_drain
+                virtual void retry ();
+                virtual void postprocessing ();
+
+                virtual void checkpoint (checkpoint_writer & writer);
+                virtual void restore (checkpoint_reader & reader);
                 
-                void shrink_path( NodeID b, NodeID v, NodeID w, node_partition & base, std::vector< NodeID > & source_bridge, std::vector< NodeID > & target_bridge, std::queue< NodeID > & Q);
-                void find_path( std::vector< NodeID > & P, NodeID x, NodeID y, std::vector< NodeID > & source_bridge, std::vector< NodeID > & target_bridge);
-                void augment_path(NodeID source); 
+                void shrink_path( NodeID b, NodeID v, NodeID w );
+                // appends the even length alternating path from x to its base y to P
+                void find_path( std::vector< NodeID > & P, NodeID x, NodeID y );
+                // gives up like at the length limit after budget scanned edges
+                void augment_path(NodeID source, unsigned long long budget = std::numeric_limits< unsigned long long >::max()); 
 
                 bool maintain_opt_fallback(NodeID source, NodeID target);
         private:
-                std::vector< NodeID > label;
-                std::vector< NodeID > pred;
-                std::vector< long > path1;
-                std::vector< long > path2;
+                // free nodes whose search was skipped in lazy mode
+                void defer( NodeID v );
+                void repair( size_t searches, unsigned long long budget );
+
+                enum local_result { LOCAL_AUGMENTED, LOCAL_NO_PATH, LOCAL_UNKNOWN };
+
+                // search for an augmenting path through the new edge {u,v} between
+                // two matched nodes, grown from both ends
+                local_result local_augment( NodeID u, NodeID v );
+                bool local_expand( int side, NodeID o, unsigned long long & budget );
+                void local_flip( NodeID free_node, NodeID end );
+
+                // forest of kept trees (--dynblossom_reuse_forest)
+                inline bool in_forest( NodeID v ) {
+                        return !forest_root.empty() && forest_root[v] != UNDEFINED_NODE;
+                }
+                void keep_tree( NodeID root );
+                void drop_tree( NodeID v );
+
+                // part of find_path still to do: the path from x to y, or reversing
+                // P from start on once the path pushed before it is complete
+                struct path_task {
+                        NodeID x;
+                        NodeID y;
+                        size_t start;
+                        bool   reverse;
+                };
+
+                std::vector< blossom_node > state;
                 std::vector< NodeID > source_bridge;
                 std::vector< NodeID > target_bridge;
                 std::vector< NodeID > reset_st_bridge;
                 std::vector< NodeID > search_started;
-                std::vector< bool > fallback_visited;
                 int iteration;
                  
-                long strue;
-                node_partition base;
+                uint32_t strue;
+                blossom_base base;
+
+                // scratch buffers of the searches, they keep their capacity
+                std::vector< NodeID > Q;
+                std::vector< NodeID > T;
+                std::vector< NodeID > P;
+                std::vector< path_task > path_tasks;
+                std::vector< NodeID > bfs_queue;
+                std::vector< NodeID > free_nodes;
+
+                deferred_searches deferred;
+
+                // a kept tree is the tree of a search that failed without hitting
+                // the length limit. trees that lean on each other form a group,
+                // its members are chained from the group root by forest_next and
+                // outer ones (even or in a blossom) are flagged
+                std::vector< NodeID > forest_root;
+                std::vector< NodeID > forest_next;
+                std::vector< unsigned char > forest_outer;
+                std::vector< NodeID > forest_touched;
+
+                // local search: stamp = epoch, side and parity of a node, the
+                // nodes a side reached as odd are its queue
+                std::vector< unsigned > local_stamp;
+                unsigned local_epoch;
+                std::vector< NodeID > local_queue[2];
+                size_t local_head[2];
+                NodeID local_found[2];
+                bool   local_clean[2];
 };
 
 #endif 
@@ -20,7 +20,7 @@ bool blossom_dyn_matching_naive::new_edge(NodeID source, NodeID target) {
         static_blossom sblossom(G, config);
         sblossom.postprocessing();
         matching_size = sblossom.getMSize();
-        matching = sblossom.getM();
+        assign_matching(sblossom.getM());
 
         return true;
 }
@@ -32,7 +32,7 @@ bool blossom_dyn_matching_naive::remove_edge(NodeID source, NodeID target) {
         static_blossom sblossom(G, config);
         sblossom.postprocessing();
         matching_size = sblossom.getMSize();
-        matching = sblossom.getM();
+        assign_matching(sblossom.getM());
 
         
         return true;
@@ -42,4 +42,7 @@ NodeID  blossom_dyn_matching_naive::getMSize () {
         return matching_size;
 }
 
-
+void blossom_dyn_matching_naive::init_matching (const std::vector< NodeID > & initial_matching) {
+        dyn_matching::init_matching(initial_matching);
+        matching_size /= 2;
+}
@@ -21,7 +21,7 @@
 #include "tools/misc.h"
 #include "node_partition.h"
 
-class blossom_dyn_matching_naive : public dyn_matching {
+class blossom_dyn_matching_naive final : public dyn_matching {
         public:
                 blossom_dyn_matching_naive (dyn_graph_access* G, MatchConfig & config); 
                 ~blossom_dyn_matching_naive (); 
@@ -29,6 +29,7 @@ class blossom_dyn_matching_naive : public dyn_matching {
                 virtual bool new_edge(NodeID source, NodeID target);
                 virtual bool remove_edge(NodeID source, NodeID target);
                 virtual NodeID getMSize ();
+                virtual void init_matching (const std::vector< NodeID > & initial_matching);
                 
 };
 
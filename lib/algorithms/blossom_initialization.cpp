@@ -0,0 +1,150 @@
+/******************************************************************************
+ * blossom_initialization.cpp
+ *
+ *****************************************************************************/
+
+#include "blossom_initialization.h"
+#include "data_structure/priority_queues/node_bucket_pq.h"
+#include "tools/neighbor_scan.h"
+#include "tools/random_functions.h"
+
+void blossom_initialization::initial_matching(dyn_graph_access * G, BlossomInitType type, std::vector< NodeID > & matching) {
+        switch( type ) {
+                case BLOSSOMEMPTY:
+                        break;
+                case BLOSSOMGREEDY:
+                        greedy(G, matching);
+                        break;
+                case BLOSSOMEXTRAGREEDY:
+                        min_degree_greedy(G, matching);
+                        break;
+                case BLOSSOMKARPSIPSER:
+                        karp_sipser(G, matching);
+                        break;
+        }
+}
+
+void blossom_initialization::greedy(dyn_graph_access * G, std::vector< NodeID > & matching) {
+        forall_nodes((*G), node) {
+                if( matching[node] != NOMATE ) continue;
+
+                size_t degree = G->getNodeDegree(node);
+                const DynEdge * edges = G->get_edges(node);
+                size_t i = neighbor_scan::first_free(edges, degree, matching, node);
+                if( i < degree ) {
+                        NodeID target    = edges[i].target;
+                        matching[node]   = target;
+                        matching[target] = node;
+                }
+        } endfor
+}
+
+void blossom_initialization::free_degrees(dyn_graph_access * G, const std::vector< NodeID > & matching, std::vector< NodeID > & free_degree) {
+        free_degree.assign(G->number_of_nodes(), 0);
+        forall_nodes((*G), node) {
+                if( matching[node] != NOMATE ) continue;
+                forall_out_edges((*G), e, node) {
+                        NodeID target = G->getEdgeTarget(node, e);
+                        if( target != node && matching[target] == NOMATE ) free_degree[node]++;
+                } endfor
+        } endfor
+}
+
+void blossom_initialization::min_degree_greedy(dyn_graph_access * G, std::vector< NodeID > & matching) {
+        std::vector< NodeID > free_degree;
+        free_degrees(G, matching, free_degree);
+
+        NodeID max_degree = 0;
+        forall_nodes((*G), node) {
+                max_degree = std::max(max_degree, free_degree[node]);
+        } endfor
+
+        // keys are negated degrees, so the max queue yields a node of minimum degree.
+        // degrees only drop, i.e. keys only grow
+        node_bucket_pq queue(G->number_of_nodes(), max_degree);
+        forall_nodes((*G), node) {
+                if( free_degree[node] > 0 ) queue.insert(node, -(Gain) free_degree[node]);
+        } endfor
+
+        while( !queue.empty() ) {
+                NodeID u = queue.deleteMax();
+
+                NodeID partner = NOMATE;
+                forall_out_edges((*G), e, u) {
+                        NodeID w = G->getEdgeTarget(u, e);
+                        if( w == u || matching[w] != NOMATE ) continue;
+                        if( partner == NOMATE || free_degree[w] < free_degree[partner] ) {
+                                partner = w;
+                                if( free_degree[w] == 1 ) break;
+                        }
+                } endfor
+
+                matching[u]       = partner;
+                matching[partner] = u;
+                queue.deleteNode(partner);
+
+                // u and partner are no longer free
+                for( NodeID x : {u, partner} ) {
+                        forall_out_edges((*G), e, x) {
+                                NodeID y = G->getEdgeTarget(x, e);
+                                if( y == x || matching[y] != NOMATE ) continue;
+                                if( --free_degree[y] == 0 ) {
+                                        queue.deleteNode(y);
+                                } else {
+                                        queue.changeKey(y, -(Gain) free_degree[y]);
+                                }
+                        } endfor
+                }
+        }
+}
+
+void blossom_initialization::karp_sipser(dyn_graph_access * G, std::vector< NodeID > & matching) {
+        std::vector< NodeID > free_degree;
+        free_degrees(G, matching, free_degree);
+
+        std::vector< NodeID > degree_one;
+        forall_nodes((*G), node) {
+                if( free_degree[node] == 1 ) degree_one.push_back(node);
+        } endfor
+
+        std::vector< NodeID > order(G->number_of_nodes());
+        random_functions::permutate_vector_fast(order, true);
+
+        auto match = [&] (NodeID u, NodeID v) {
+                matching[u] = v;
+                matching[v] = u;
+                for( NodeID x : {u, v} ) {
+                        forall_out_edges((*G), e, x) {
+                                NodeID y = G->getEdgeTarget(x, e);
+                                if( y == x || matching[y] != NOMATE ) continue;
+                                if( --free_degree[y] == 1 ) degree_one.push_back(y);
+                        } endfor
+                }
+        };
+
+        // degree one reductions never cost optimality
+        auto reduce = [&] () {
+                while( !degree_one.empty() ) {
+                        NodeID v = degree_one.back(); degree_one.pop_back();
+                        if( matching[v] != NOMATE || free_degree[v] != 1 ) continue;
+
+                        size_t i = neighbor_scan::first_free(G->get_edges(v), G->getNodeDegree(v), matching, v);
+                        if( i < G->getNodeDegree(v) ) match(v, G->getEdgeTarget(v, i));
+                }
+        };
+
+        std::vector< NodeID > candidates;
+        for( NodeID u : order ) {
+                reduce();
+                if( matching[u] != NOMATE || free_degree[u] == 0 ) continue;
+
+                // otherwise a random free edge out of a random free node
+                candidates.clear();
+                forall_out_edges((*G), e, u) {
+                        NodeID w = G->getEdgeTarget(u, e);
+                        if( w != u && matching[w] == NOMATE ) candidates.push_back(w);
+                } endfor
+                match(u, candidates[random_functions::nextInt(0, candidates.size() - 1)]);
+        }
+        reduce();
+}
@@ -0,0 +1,39 @@
+/******************************************************************************
+ * blossom_initialization.h
+ *
+ * Initial matchings for the static blossom algorithm. Every matched pair
+ * saves one augmenting path search later on, so a better start pays off.
+ *
+ *****************************************************************************/
+
+#ifndef BLOSSOM_INITIALIZATION_H
+#define BLOSSOM_INITIALIZATION_H
+
+#include <vector>
+
+#include "definitions.h"
+#include "data_structure/dyn_graph_access.h"
+
+class blossom_initialization {
+        public:
+                // extends matching (NOMATE for free nodes) to a maximal matching of G
+                // with the method selected by type. BLOSSOMEMPTY leaves it as it is
+                static void initial_matching(dyn_graph_access * G, BlossomInitType type, std::vector< NodeID > & matching);
+
+        private:
+                // matches every free node to its first free neighbour
+                static void greedy(dyn_graph_access * G, std::vector< NodeID > & matching);
+
+                // matches a free node with the fewest free neighbours to its
+                // neighbour with the fewest free neighbours
+                static void min_degree_greedy(dyn_graph_access * G, std::vector< NodeID > & matching);
+
+                // matches nodes with a single free neighbour first, which is always
+                // optimal, and a random free edge when there are none
+                static void karp_sipser(dyn_graph_access * G, std::vector< NodeID > & matching);
+
+                // number of free neighbours of every free node, self loops do not count
+                static void free_degrees(dyn_graph_access * G, const std::vector< NodeID > & matching, std::vector< NodeID > & free_degree);
+};
+
+#endif
@@ -1,16 +1,42 @@
 #include "dyn_matching.h"
 
+// definitions of the constants of the header only helpers that are bound to
+// references, e.g. by std::vector::assign
+const NodeID free_neighbor_counts::NOT_COUNTED;
+const NodeID free_vertex_index::NOT_FREE;
+
 dyn_matching::dyn_matching (dyn_graph_access* G, MatchConfig & config) {
         this->G = G;
         this->config = config;
 
         matching.resize(G->number_of_nodes(), NOMATE);
         matching_size = 0;
+        m_log_deltas = false;
+        m_count_free_neighbors = false;
+        m_index_free_vertices  = false;
+        m_index_by_degree      = false;
+}
+
+void dyn_matching::enable_free_neighbor_counts () {
+        m_count_free_neighbors = true;
+        free_neighbors.init(G, matching);
+}
+
+void dyn_matching::enable_free_vertex_index (bool by_degree) {
+        m_index_free_vertices = true;
+        m_index_by_degree     = by_degree;
+        free_vertices.init(G, matching, by_degree);
 }
 
 dyn_matching::~dyn_matching () {
 }
 
+void dyn_matching::remove_edges(const std::vector< std::pair< NodeID, NodeID > > & edges) {
+        for( size_t i = 0; i < edges.size(); i++) {
+                remove_edge(edges[i].first, edges[i].second);
+        }
+}
+
 std::vector<NodeID> & dyn_matching::getM () {
         return matching;
 }
@@ -19,42 +45,43 @@ NodeID dyn_matching::getMSize () {
         return matching_size/2;
 }
 
-bool dyn_matching::is_free (NodeID u) {
-        return matching[u] == NOMATE;
-}
-
-bool dyn_matching::is_matched (NodeID u, NodeID v) {
-        if (is_free(u) || is_free(v)) return false;
+void dyn_matching::init_matching (const std::vector< NodeID > & initial_matching) {
+        assign_matching(initial_matching);
 
-        ASSERT_TRUE((matching[u] == v) == (matching[v] == u));
-        return matching[u] == v && matching[v] == u;
+        matching_size = 0;
+        for( NodeID u = 0; u < matching.size(); u++) {
+                if( matching[u] != NOMATE ) matching_size++;
+        }
 }
 
-NodeID dyn_matching::mate (NodeID u) {
-        return matching[u];
+void dyn_matching::assign_matching (const std::vector< NodeID > & new_matching) {
+        if( m_log_deltas ) {
+                // each pair is logged from its smaller endpoint
+                for( NodeID u = 0; u < matching.size(); u++) {
+                        if( matching[u] != new_matching[u] && matching[u] != NOMATE && u < matching[u] ) {
+                                log_delta(u, matching[u], false);
+                        }
+                }
+                for( NodeID u = 0; u < matching.size(); u++) {
+                        if( matching[u] != new_matching[u] && new_matching[u] != NOMATE && u < new_matching[u] ) {
+                                log_delta(u, new_matching[u], true);
+                        }
+                }
+        }
+        matching = new_matching;
+        if( m_count_free_neighbors ) free_neighbors.init(G, matching);
+        if( m_index_free_vertices )  free_vertices.init(G, matching, m_index_by_degree);
 }
 
-void dyn_matching::match (NodeID u, NodeID v) {
-        ASSERT_TRUE(is_free(u));
-        ASSERT_TRUE(is_free(v));
-        ASSERT_TRUE(u != v);
-
-        matching[u] = v;
-        matching[v] = u;
-
-        matching_size += 2;
+void dyn_matching::checkpoint (checkpoint_writer & writer) {
+        writer.write_vector(matching);
+        writer.write(matching_size);
 }
 
-void dyn_matching::unmatch (NodeID u, NodeID v) {
-        ASSERT_TRUE(!is_free(u));
-        ASSERT_TRUE(!is_free(v));
-        ASSERT_TRUE(u != v);
-
-        matching[u] = NOMATE;
-        matching[v] = NOMATE;
-
-        matching_size -= 2;
+void dyn_matching::restore (checkpoint_reader & reader) {
+        reader.read_vector(matching);
+        reader.read(matching_size);
+        matching.resize(G->number_of_nodes(), NOMATE);
+        if( m_count_free_neighbors ) free_neighbors.init(G, matching);
+        if( m_index_free_vertices )  free_vertices.init(G, matching, m_index_by_degree);
 }
-
-
-
@@ -14,8 +14,12 @@
 #include <unordered_map>
 
 #include "data_structure/dyn_graph_access.h"
+#include "data_structure/free_neighbor_counts.h"
+#include "data_structure/free_vertex_index.h"
 #include "definitions.h"
+#include "io/checkpoint_io.h"
 #include "match_config.h"
+#include "tools/neighbor_scan.h"
 
 class dyn_matching {
         public:
@@ -25,11 +29,29 @@ class dyn_matching {
                 virtual bool new_edge(NodeID source, NodeID target) = 0;
                 virtual bool remove_edge(NodeID source, NodeID target) = 0;
 
+                // a run of deletions at once, by default one after the other.
+                // algorithms that can repair the freed nodes together override it
+                virtual void remove_edges(const std::vector< std::pair< NodeID, NodeID > > & edges);
+
                 virtual std::vector< NodeID > & getM ();
                 virtual NodeID getMSize ();
 
                 virtual void retry () { }
                 virtual void postprocessing() { }
+
+                // warm start after the graph was bulk loaded: takes over the given
+                // matching of G and builds the auxiliary structures from it
+                virtual void init_matching (const std::vector< NodeID > & initial_matching);
+
+                // optional log of all changes of the matching, in the order they
+                // happened. drain_deltas hands out the changes since the last drain
+                void log_deltas (bool enable) { m_log_deltas = enable; m_deltas.clear(); }
+                void drain_deltas (std::vector< MatchingDelta > & deltas) { deltas.clear(); deltas.swap(m_deltas); }
+
+                // binary checkpoints of the algorithm state, see io/checkpoint_io.h.
+                // algorithms with state beyond the matching extend both
+                virtual void checkpoint (checkpoint_writer & writer);
+                virtual void restore (checkpoint_reader & reader);
         protected:
                 dyn_graph_access* G;
 
@@ -37,11 +59,158 @@ class dyn_matching {
                 NodeID matching_size;
                 MatchConfig config;
 
-                virtual bool is_free (NodeID u);
-                virtual NodeID mate (NodeID u);
-                virtual bool is_matched (NodeID u, NodeID v);
-                virtual void match (NodeID u, NodeID v);
-                virtual void unmatch (NodeID u, NodeID v);
+                // these are called in the innermost loops of all algorithms, hence
+                // they are not virtual and defined inline below
+                inline bool is_free (NodeID u);
+                inline NodeID mate (NodeID u);
+                inline bool is_matched (NodeID u, NodeID v);
+                inline void match (NodeID u, NodeID v);
+                inline void unmatch (NodeID u, NodeID v);
+
+                // for algorithms that write the matching directly, e.g. along an
+                // augmenting path. rematch makes u and v mates and releases their
+                // old mates, release unmatches u and v. both leave matching_size alone
+                inline void rematch (NodeID u, NodeID v);
+                inline void release (NodeID u, NodeID v);
+                void assign_matching (const std::vector< NodeID > & new_matching);
+
+                inline void log_delta (NodeID u, NodeID v, bool matched);
+
+                // the first free neighbor v of u other than avoid, see
+                // tools/neighbor_scan.h. pass NOMATE to avoid nothing
+                inline bool free_neighbor (NodeID u, NodeID avoid, NodeID & v);
+
+                // optional free neighbor counts and index of the free nodes, kept up
+                // to date by the functions above once enabled. algorithms that enable
+                // the counts or the index by degree report the edge updates that
+                // changed the graph with count_new_edge and count_removed_edge, after
+                // the graph and before the matching changes
+                void enable_free_neighbor_counts ();
+                void enable_free_vertex_index (bool by_degree);
+                inline void count_new_edge (NodeID u, NodeID v);
+                inline void count_removed_edge (NodeID u, NodeID v);
+                inline void became_free (NodeID u);
+                inline void became_matched (NodeID u);
+
+                bool                 m_count_free_neighbors;
+                free_neighbor_counts free_neighbors;
+
+                bool                 m_index_free_vertices;
+                bool                 m_index_by_degree;
+                free_vertex_index    free_vertices;
+
+                bool m_log_deltas;
+                std::vector< MatchingDelta > m_deltas;
 };
 
+bool dyn_matching::is_free (NodeID u) {
+        return matching[u] == NOMATE;
+}
+
+bool dyn_matching::is_matched (NodeID u, NodeID v) {
+        if (is_free(u) || is_free(v)) return false;
+
+        ASSERT_TRUE((matching[u] == v) == (matching[v] == u));
+        return matching[u] == v && matching[v] == u;
+}
+
+NodeID dyn_matching::mate (NodeID u) {
+        return matching[u];
+}
+
+void dyn_matching::match (NodeID u, NodeID v) {
+        ASSERT_TRUE(is_free(u));
+        ASSERT_TRUE(is_free(v));
+        ASSERT_TRUE(u != v);
+
+        matching[u] = v;
+        matching[v] = u;
+        log_delta(u, v, true);
+        became_matched(u);
+        became_matched(v);
+
+        matching_size += 2;
+}
+
+void dyn_matching::unmatch (NodeID u, NodeID v) {
+        ASSERT_TRUE(!is_free(u));
+        ASSERT_TRUE(!is_free(v));
+        ASSERT_TRUE(u != v);
+
+        matching[u] = NOMATE;
+        matching[v] = NOMATE;
+        log_delta(u, v, false);
+        became_free(u);
+        became_free(v);
+
+        matching_size -= 2;
+}
+
+void dyn_matching::rematch (NodeID u, NodeID v) {
+        ASSERT_TRUE(u != v);
+        if( matching[u] == v ) return;
+
+        // an old pair is logged by whichever endpoint is rematched first
+        NodeID old_u = matching[u];
+        NodeID old_v = matching[v];
+        if( old_u != NOMATE && matching[old_u] == u ) { matching[old_u] = NOMATE; log_delta(u, old_u, false); became_free(old_u); }
+        if( old_v != NOMATE && matching[old_v] == v ) { matching[old_v] = NOMATE; log_delta(v, old_v, false); became_free(old_v); }
+
+        matching[u] = v;
+        matching[v] = u;
+        log_delta(u, v, true);
+        if( old_u == NOMATE ) became_matched(u);
+        if( old_v == NOMATE ) became_matched(v);
+}
+
+void dyn_matching::release (NodeID u, NodeID v) {
+        ASSERT_TRUE(matching[u] == v && matching[v] == u);
+
+        matching[u] = NOMATE;
+        matching[v] = NOMATE;
+        log_delta(u, v, false);
+        became_free(u);
+        became_free(v);
+}
+
+void dyn_matching::log_delta (NodeID u, NodeID v, bool matched) {
+        if( !m_log_deltas ) return;
+
+        MatchingDelta delta;
+        delta.u = u;
+        delta.v = v;
+        delta.matched = matched;
+        m_deltas.push_back(delta);
+}
+
+bool dyn_matching::free_neighbor (NodeID u, NodeID avoid, NodeID & v) {
+        size_t degree = G->getNodeDegree(u);
+        const DynEdge * edges = G->get_edges(u);
+        size_t i = neighbor_scan::first_free(edges, degree, matching, avoid);
+        if( i == degree ) return false;
+
+        v = edges[i].target;
+        return true;
+}
+
+void dyn_matching::count_new_edge (NodeID u, NodeID v) {
+        if( m_count_free_neighbors ) free_neighbors.edge_added(u, v, is_free(u), is_free(v));
+        if( m_index_by_degree ) { free_vertices.degree_changed(u); free_vertices.degree_changed(v); }
+}
+
+void dyn_matching::count_removed_edge (NodeID u, NodeID v) {
+        if( m_count_free_neighbors ) free_neighbors.edge_removed(u, v, is_free(u), is_free(v));
+        if( m_index_by_degree ) { free_vertices.degree_changed(u); free_vertices.degree_changed(v); }
+}
+
+void dyn_matching::became_free (NodeID u) {
+        if( m_count_free_neighbors ) free_neighbors.became_free(u);
+        if( m_index_free_vertices )  free_vertices.insert(u);
+}
+
+void dyn_matching::became_matched (NodeID u) {
+        if( m_count_free_neighbors ) free_neighbors.became_matched(u);
+        if( m_index_free_vertices )  free_vertices.erase(u);
+}
+
 #endif // DYN_MATCHING_H
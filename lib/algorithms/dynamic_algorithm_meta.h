@@ -5,33 +5,122 @@
 #define DYNAMIC_ALGORITHM_META_2LKHAHEY
 
 
-void run_dynamic_algorithm(dyn_graph_access * G, std::vector<std::pair<int, std::pair<NodeID, NodeID> > > &edge_sequence, dyn_matching * algorithm, MatchConfig & match_config ) {
+// exact solve after the last update, warm started from the dynamic matching
+template< typename algorithm_type, typename engine_type >
+void run_post_blossom(dyn_graph_access * G, algorithm_type * algorithm, engine_type * engine, timer & t) {
+        timer tpost; tpost._restart();
+        engine->init(algorithm->getM());
+        engine->postprocessing();
+        NodeID matching_size = engine->getMSize();
+
+        std::cout <<  "postprocessing took " <<  tpost._elapsed() << std::endl;
+        std::cout << matching_size << " " << " " << t._elapsed() << std::endl;
+        check_matching(G, engine, matching_size); 
+}
+
+// The driver is instantiated for each concrete algorithm class. Since those
+// are final, the per update calls below are resolved at compile time.
+template< typename algorithm_type >
+void run_dynamic_algorithm(dyn_graph_access * G, std::vector<std::pair<int, std::pair<NodeID, NodeID> > > &edge_sequence, algorithm_type * algorithm, MatchConfig & match_config ) {
+        size_t start = 0;
+        if( !match_config.restore_filename.empty() ) {
+                timer trestore; trestore._restart();
+                uint64_t position = 0;
+                if( checkpoint_io::read(match_config.restore_filename, G, algorithm, match_config.algorithm, position) ) {
+                        exit(1);
+                }
+                start = std::min((size_t) position, edge_sequence.size());
+                std::cout <<  "restore took " <<  trestore._elapsed() << ", continuing at update " << start << std::endl;
+        }
+
         timer t; 
         t._restart(); 
 
+        if( match_config.bulk_load && start == 0 ) {
+                // the prefix ends at the first deletion
+                size_t prefix = 0;
+                size_t limit  = match_config.bulk_load_prefix > 0 ? std::min((size_t) match_config.bulk_load_prefix, edge_sequence.size()) : edge_sequence.size();
+                while( prefix < limit && edge_sequence[prefix].first ) prefix++;
+
+                timer tbulk; tbulk._restart();
+                G->bulk_load(edge_sequence, 0, prefix);
+                double graph_time = tbulk._elapsed();
+
+                static_blossom sblossom(G, match_config);
+                sblossom.postprocessing();
+                algorithm->init_matching(sblossom.getM());
+                start = prefix;
+
+                std::cout <<  "bulk load of " << prefix << " insertions took " <<  tbulk._elapsed()  
+                          <<  " (graph " << graph_time << ")" << std::endl;
+        }
+
+        // periodic checkpoints are written by a forked child, at most one at a time.
+        // they are counted from where the replay starts, i.e. after a restore
+        // or a bulk load
+        const std::string & checkpoint_filename = match_config.checkpoint_filename;
+        size_t next_checkpoint = std::numeric_limits< size_t >::max();
+        if( !checkpoint_filename.empty() && match_config.checkpoint_every > 0 ) {
+                next_checkpoint = start + match_config.checkpoint_every;
+        }
+        pid_t checkpoint_writer = -1;
+
         unsigned long matching_size = 0;
-        for (size_t i = 0; i < edge_sequence.size(); ++i) { 
+        std::vector< std::pair< NodeID, NodeID > > batch;
+        for (size_t i = start; i < edge_sequence.size(); ++i) { 
                 std::pair<NodeID, NodeID> & edge = edge_sequence[i].second;
 
                 if (edge_sequence.at(i).first) {
                         algorithm->new_edge(edge.first, edge.second);
+                } else if( match_config.batch_size > 1 ) {
+                        // a run of deletions, cut at the next checkpoint. the batch
+                        // always holds update i, so i never moves backwards
+                        size_t stop = std::min(edge_sequence.size(), i + match_config.batch_size);
+                        if( next_checkpoint > i ) stop = std::min(stop, next_checkpoint);
+                        batch.clear();
+                        for( size_t j = i; j < stop && !edge_sequence[j].first; j++) {
+                                batch.push_back(edge_sequence[j].second);
+                        }
+                        algorithm->remove_edges(batch);
+                        i += batch.size() - 1;
                 } else {
                         algorithm->remove_edge(edge.first, edge.second);
                 }
+
+                if( i + 1 == next_checkpoint ) {
+                        if( checkpoint_writer > 0 && checkpoint_io::wait(checkpoint_writer) ) {
+                                std::cerr <<  "writing a checkpoint failed"  << std::endl;
+                        }
+                        checkpoint_writer = checkpoint_io::write_async(checkpoint_filename, G, algorithm, match_config.algorithm, i + 1);
+                        if( checkpoint_writer < 0 ) {
+                                checkpoint_io::write(checkpoint_filename, G, algorithm, match_config.algorithm, i + 1);
+                        }
+                        next_checkpoint += match_config.checkpoint_every;
+                }
         } 
+        if( checkpoint_writer > 0 && checkpoint_io::wait(checkpoint_writer) ) {
+                std::cerr <<  "writing a checkpoint failed"  << std::endl;
+        }
+        if( !checkpoint_filename.empty() ) {
+                timer tcheckpoint; tcheckpoint._restart();
+                checkpoint_io::write(checkpoint_filename, G, algorithm, match_config.algorithm, edge_sequence.size());
+                std::cout <<  "checkpoint took " <<  tcheckpoint._elapsed() << std::endl;
+        }
         algorithm->postprocessing(); 
         matching_size = algorithm->getMSize();
 
-        if (match_config.post_blossom) {
-                timer tpost; tpost._restart();
+        if (match_config.post_blossom && !match_config.sides.empty()) {
+                hopcroft_karp hk(G, match_config);
+                run_post_blossom(G, algorithm, &hk, t);
+        } else if (match_config.post_blossom && match_config.static_engine == STATIC_PHASES) {
+                phase_blossom pblossom(G, match_config);
+                run_post_blossom(G, algorithm, &pblossom, t);
+        } else if (match_config.post_blossom && match_config.static_engine == STATIC_PARALLEL) {
+                parallel_blossom pblossom(G, match_config);
+                run_post_blossom(G, algorithm, &pblossom, t);
+        } else if (match_config.post_blossom) {
                 static_blossom sblossom(G, match_config);
-                sblossom.init(algorithm->getM());
-                sblossom.postprocessing();
-                matching_size = sblossom.getMSize();
-
-                std::cout <<  "postprocessing took " <<  tpost._elapsed() << std::endl;
-                std::cout << matching_size << " " << " " << t._elapsed() << std::endl;
-                check_matching(G, &sblossom, matching_size); 
+                run_post_blossom(G, algorithm, &sblossom, t);
         } else {
                 std::cout << matching_size << " " << " " << t._elapsed() << std::endl;
                 check_matching(G, algorithm, matching_size); 
@@ -0,0 +1,146 @@
+/******************************************************************************
+ * hopcroft_karp.cpp
+ *
+ *****************************************************************************/
+
+#include "hopcroft_karp.h"
+#include "blossom_initialization.h"
+
+hopcroft_karp::hopcroft_karp(dyn_graph_access* G, MatchConfig & match_config) : dyn_matching(G, match_config), side(match_config.sides), initalized(false) {
+}
+
+hopcroft_karp::~hopcroft_karp() {
+
+}
+
+bool hopcroft_karp::new_edge(NodeID source, NodeID target) {
+        G->new_edge(source, target);
+        G->new_edge(target, source);
+        return true;
+}
+
+bool hopcroft_karp::remove_edge(NodeID source, NodeID target) {
+        G->remove_edge(source, target);
+        G->remove_edge(target, source);
+        return true;
+}
+
+NodeID hopcroft_karp::getMSize () {
+        return matching_size;
+}
+
+void hopcroft_karp::init( std::vector< NodeID > & matching_param ) {
+        forall_nodes((*G), node) {
+                NodeID m = matching_param[node];
+                if( m != NOMATE && node < m && matching[node] != m ) {
+                        if( matching[node] != NOMATE ) matching_size--;
+                        if( matching[m] != NOMATE )    matching_size--;
+                        rematch(node, m);
+                        matching_size++;
+                }
+        } endfor
+        initalized = true;
+}
+
+void hopcroft_karp::init_matching (const std::vector< NodeID > & initial_matching) {
+        dyn_matching::init_matching(initial_matching);
+        matching_size /= 2;
+        initalized = true;
+}
+
+void hopcroft_karp::checkpoint (checkpoint_writer & writer) {
+        dyn_matching::checkpoint(writer);
+        writer.write(initalized);
+}
+
+void hopcroft_karp::restore (checkpoint_reader & reader) {
+        dyn_matching::restore(reader);
+        reader.read(initalized);
+}
+
+void hopcroft_karp::postprocessing() {
+        if( !initalized ) {
+                std::vector< NodeID > initial(matching);
+                blossom_initialization::initial_matching(G, config.blossom_init, initial);
+                init(initial);
+        }
+
+        left.clear();
+        forall_nodes((*G), node) {
+                if( side[node] == 0 && G->getNodeDegree(node) > 0 ) left.push_back(node);
+        } endfor
+        distance.assign(G->number_of_nodes(), UNDEFINED_NODE);
+        next_edge.assign(G->number_of_nodes(), 0);
+
+        while( bfs() && dfs() > 0 ) ;
+}
+
+bool hopcroft_karp::bfs() {
+        Q.clear();
+        for( NodeID u : left ) {
+                if( matching[u] == NOMATE ) {
+                        distance[u] = 0;
+                        Q.push_back(u);
+                } else {
+                        distance[u] = UNDEFINED_NODE;
+                }
+        }
+
+        // stop at the layer of the first free node of side 1
+        NodeID shortest = UNDEFINED_NODE;
+        for( size_t head = 0; head < Q.size(); head++) {
+                NodeID u = Q[head];
+                if( distance[u] >= shortest ) break;
+
+                forall_out_edges((*G), e, u) {
+                        NodeID w = matching[G->getEdgeTarget(u, e)];
+                        if( w == NOMATE ) {
+                                shortest = distance[u] + 1;
+                        } else if( distance[w] == UNDEFINED_NODE ) {
+                                distance[w] = distance[u] + 1;
+                                Q.push_back(w);
+                        }
+                } endfor
+        }
+        return shortest != UNDEFINED_NODE;
+}
+
+NodeID hopcroft_karp::dfs() {
+        NodeID augmentations = 0;
+        for( NodeID u : left ) next_edge[u] = 0;
+
+        for( NodeID root : left ) {
+                if( matching[root] != NOMATE || distance[root] != 0 ) continue;
+
+                stack.clear(); stack.push_back(root);
+                while( !stack.empty() ) {
+                        NodeID u = stack.back();
+                        if( next_edge[u] == G->getNodeDegree(u) ) {
+                                // dead end for the rest of the phase
+                                distance[u] = UNDEFINED_NODE;
+                                stack.pop_back();
+                                continue;
+                        }
+
+                        NodeID v = G->getEdgeTarget(u, next_edge[u]);
+                        NodeID w = matching[v];
+                        if( w == NOMATE ) {
+                                // stack[i] is matched to the node its next edge points to
+                                for( NodeID x : stack ) {
+                                        rematch(x, G->getEdgeTarget(x, next_edge[x]));
+                                        distance[x] = UNDEFINED_NODE;
+                                }
+                                matching_size++;
+                                augmentations++;
+                                break;
+                        }
+
+                        if( distance[w] == distance[u] + 1 ) {
+                                stack.push_back(w);
+                        } else {
+                                next_edge[u]++;
+                        }
+                }
+        }
+        return augmentations;
+}
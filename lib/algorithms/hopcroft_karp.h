@@ -0,0 +1,53 @@
+/******************************************************************************
+ * hopcroft_karp.h
+ *
+ * Exact maximum matching for bipartite graphs (Hopcroft-Karp). Each phase
+ * layers the graph by a BFS from all free nodes of side 0 and then augments
+ * along a maximal set of node disjoint shortest paths, found by DFS on the
+ * layers. O(m sqrt(n)).
+ *
+ *****************************************************************************/
+
+#ifndef HOPCROFT_KARP_H
+#define HOPCROFT_KARP_H
+
+#include <vector>
+
+#include "dyn_matching.h"
+
+class hopcroft_karp final : public dyn_matching {
+        public:
+                // config.sides holds the side of every node
+                hopcroft_karp (dyn_graph_access* G, MatchConfig & config);
+                ~hopcroft_karp ();
+
+                virtual bool new_edge(NodeID source, NodeID target);
+                virtual bool remove_edge(NodeID source, NodeID target);
+                virtual NodeID getMSize ();
+                virtual void postprocessing();
+                virtual void init_matching (const std::vector< NodeID > & initial_matching);
+
+                virtual void checkpoint (checkpoint_writer & writer);
+                virtual void restore (checkpoint_reader & reader);
+
+                // warm start from the given matching instead of blossom_init
+                void init( std::vector< NodeID > & matching );
+
+        private:
+                // layers the graph, returns false if there is no augmenting path
+                bool bfs();
+                // augments along node disjoint shortest paths, returns their number
+                NodeID dfs();
+
+                const std::vector< NodeID > & side;
+
+                std::vector< NodeID > left;      // nodes of side 0 with edges
+                std::vector< NodeID > distance;  // layer of nodes of side 0
+                std::vector< EdgeID > next_edge; // DFS position of nodes of side 0
+                std::vector< NodeID > Q;
+                std::vector< NodeID > stack;
+
+                bool initalized;
+};
+
+#endif
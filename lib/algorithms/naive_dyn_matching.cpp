@@ -7,12 +7,14 @@
 #include "naive_dyn_matching.h"
 
 naive_dyn_matching::naive_dyn_matching (dyn_graph_access* G, MatchConfig & match_config) : dyn_matching(G, match_config) {
+        if( config.free_neighbor_counts ) enable_free_neighbor_counts();
 }
 
 bool naive_dyn_matching::new_edge(NodeID source, NodeID target) {
 
-        G->new_edge(source, target);
+        bool added = G->new_edge(source, target);
         G->new_edge(target, source);
+        if( added ) count_new_edge(source, target);
 
         // check whether the vertices are free. if so, add to the matching
         if (is_free(source) && is_free(target)) {
@@ -45,8 +47,9 @@ bool naive_dyn_matching::new_edge(NodeID source, NodeID target) {
 
 // CS change function to void
 bool naive_dyn_matching::remove_edge(NodeID source, NodeID target) {
-        G->remove_edge(source, target);
+        bool removed = G->remove_edge(source, target);
         G->remove_edge(target, source);
+        if( removed ) count_removed_edge(source, target);
 
         /* starting calculation of matching */
         if (is_matched(source, target)) {
@@ -61,28 +64,10 @@ bool naive_dyn_matching::remove_edge(NodeID source, NodeID target) {
 }
 
 bool naive_dyn_matching::settle (NodeID u, const NodeID* avoid_ptr) {
-        EdgeID deg_u = G->get_first_invalid_edge(u);
-        NodeID v;
-        NodeID avoid = 0;
-        bool mate_found = false;
-        bool avoid_defined = (avoid_ptr != nullptr);
-        
-        if (avoid_defined) {
-                avoid = *avoid_ptr;
-        }
+        if( m_count_free_neighbors && !free_neighbors.any(u) ) return false;
 
-        for (EdgeID i = 0; i < deg_u; ++i) {
-                v = G->getEdgeTarget(u, i);
-                if (avoid_defined) {
-                       if(v == avoid) 
-                        continue;
-                }
-                
-                if (is_free(v)) {
-                        mate_found = true;
-                        break;
-                }
-        }
+        NodeID v;
+        bool mate_found = free_neighbor(u, avoid_ptr != nullptr ? *avoid_ptr : NOMATE, v);
 
         if (mate_found) {
                 match(u, v);
@@ -19,7 +19,7 @@
 #include "tools/timer.h"
 
 
-class naive_dyn_matching : public dyn_matching {
+class naive_dyn_matching final : public dyn_matching {
         public:
                 naive_dyn_matching (dyn_graph_access* G, MatchConfig & config);
 
@@ -159,8 +159,7 @@ void neimansolomon_dyn_matching::match (NodeID u, NodeID v) {
                 }
         }
         
-        matching[u] = v;
-        matching[v] = u;
+        rematch(u, v);
         
         matching_size += 2;
         
@@ -326,3 +325,55 @@ void neimansolomon_dyn_matching::handle_problematic () {
         }
 }
 
+void neimansolomon_dyn_matching::init_matching (const std::vector< NodeID > & initial_matching) {
+        dyn_matching::init_matching(initial_matching);
+
+        // F holds the free neighbours of every vertex, F_max all free vertices
+        for (NodeID u = 0; u < G->number_of_nodes(); ++u) {
+                if (F_max.contains(u)) F_max.deleteNode(u);
+                F[u].free.clear();
+        }
+        for (NodeID u = 0; u < G->number_of_nodes(); ++u) {
+                if (!is_free(u)) continue;
+
+                F_max.insert(u, deg(u));
+                for( unsigned int e = 0; e < G->getNodeDegree(u); e++) {
+                        F[G->getEdgeTarget(u,e)].insert(u);
+                }
+        }
+
+        // an update fixes at most one free vertex of too high degree, here
+        // all of them are fixed up front
+        for (NodeID i = 0; i < G->number_of_nodes() && !F_max.empty(); ++i) {
+                if (deg(F_max.maxElement()) <= std::sqrt(2 * G->number_of_nodes())) break;
+                handle_problematic();
+        }
+}
+
+void neimansolomon_dyn_matching::checkpoint (checkpoint_writer & writer) {
+        dyn_matching::checkpoint(writer);
+
+        std::vector< NodeID > free_neighbours;
+        for (NodeID u = 0; u < F.size(); ++u) {
+                free_neighbours.clear();
+                for (auto & entry : F[u].free) {
+                        free_neighbours.push_back(entry.first);
+                }
+                writer.write_vector(free_neighbours);
+        }
+        F_max.checkpoint(writer);
+}
+
+void neimansolomon_dyn_matching::restore (checkpoint_reader & reader) {
+        dyn_matching::restore(reader);
+
+        for (NodeID u = 0; u < F.size(); ++u) {
+                uint64_t count = 0;
+                const NodeID * free_neighbours = reader.read_array< NodeID >(count);
+                F[u].free.clear();
+                for (uint64_t i = 0; i < count; ++i) {
+                        F[u].insert(free_neighbours[i]);
+                }
+        }
+        F_max.restore(reader);
+}
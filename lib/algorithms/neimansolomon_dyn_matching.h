@@ -22,12 +22,16 @@
 #include "data_structure/priority_queues/node_bucket_pq.h"
 #include "tools/timer.h"
 
-class neimansolomon_dyn_matching : public dyn_matching {
+class neimansolomon_dyn_matching final : public dyn_matching {
         public:
                 neimansolomon_dyn_matching (dyn_graph_access* G, MatchConfig & config);
 
                 virtual bool new_edge(NodeID source, NodeID target);
                 virtual bool remove_edge(NodeID source, NodeID target);
+                virtual void init_matching (const std::vector< NodeID > & initial_matching);
+
+                virtual void checkpoint (checkpoint_writer & writer);
+                virtual void restore (checkpoint_reader & reader);
 
 
         private:
@@ -0,0 +1,320 @@
+/******************************************************************************
+ * parallel_blossom.cpp
+ *
+ *****************************************************************************/
+
+#include <algorithm>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include "parallel_blossom.h"
+#include "phase_blossom.h"
+
+parallel_blossom::parallel_blossom(dyn_graph_access* G, MatchConfig & match_config) : dyn_matching(G, match_config), initalized(false) {
+        m_threads = std::max(1, config.threads);
+#ifndef _OPENMP
+        m_threads = 1;
+#endif
+        label.resize(G->number_of_nodes(), UNLABELED);
+        enable_free_vertex_index(true);
+}
+
+parallel_blossom::~parallel_blossom() {
+
+}
+
+bool parallel_blossom::new_edge(NodeID source, NodeID target) {
+        bool added = G->new_edge(source, target);
+        G->new_edge(target, source);
+        if( added ) count_new_edge(source, target);
+        return true;
+}
+
+bool parallel_blossom::remove_edge(NodeID source, NodeID target) {
+        bool removed = G->remove_edge(source, target);
+        G->remove_edge(target, source);
+        if( removed ) count_removed_edge(source, target);
+        return true;
+}
+
+NodeID parallel_blossom::getMSize () {
+        return matching_size;
+}
+
+void parallel_blossom::init( std::vector< NodeID > & matching_param ) {
+        forall_nodes((*G), node) {
+                NodeID m = matching_param[node];
+                if( m != NOMATE && node < m && matching[node] != m ) {
+                        if( matching[node] != NOMATE ) matching_size--;
+                        if( matching[m] != NOMATE )    matching_size--;
+                        rematch(node, m);
+                        matching_size++;
+                }
+        } endfor
+        initalized = true;
+}
+
+void parallel_blossom::init_matching (const std::vector< NodeID > & initial_matching) {
+        dyn_matching::init_matching(initial_matching);
+        matching_size /= 2;
+        initalized = true;
+}
+
+// same layout as static_blossom, both run as BLOSSOM
+void parallel_blossom::checkpoint (checkpoint_writer & writer) {
+        dyn_matching::checkpoint(writer);
+        writer.write_vector(label);
+        writer.write(initalized);
+}
+
+void parallel_blossom::restore (checkpoint_reader & reader) {
+        dyn_matching::restore(reader);
+        reader.read_vector(label);
+        reader.read(initalized);
+        label.assign(G->number_of_nodes(), UNLABELED);
+}
+
+void parallel_blossom::postprocessing() {
+        NodeID n = G->number_of_nodes();
+        owner.reset(new std::atomic< NodeID >[n]);
+        for( NodeID v = 0; v < n; v++) owner[v].store(0, std::memory_order_relaxed);
+
+        if( !initalized && config.blossom_init != BLOSSOMEMPTY ) {
+                parallel_greedy();
+        }
+        initalized = true;
+
+        label.assign(n, UNLABELED);
+        pred.assign(n, UNDEFINED_NODE);
+        source_bridge.assign(n, UNDEFINED_NODE);
+        target_bridge.assign(n, UNDEFINED_NODE);
+        path1.assign(n, 0);
+        path2.assign(n, 0);
+        base.init(G);
+        states.assign(m_threads, search_state());
+
+        // a round is worth it while there are enough roots and a noticeable share
+        // of its searches succeed, the last few paths are left to the sequential engine
+        std::vector< NodeID > roots;
+        for( ;; ) {
+                free_vertices.sorted(roots, true);
+                if( roots.size() < 16 * (size_t) m_threads ) break;
+
+                NodeID augmentations = parallel_round(roots);
+                if( augmentations == 0 || augmentations < roots.size() / 64 ) break;
+        }
+        states.clear();
+        owner.reset();
+
+        phase_blossom cleanup(G, config);
+        cleanup.init(matching);
+        cleanup.postprocessing();
+        assign_matching(cleanup.getM());
+        matching_size = cleanup.getMSize();
+}
+
+void parallel_blossom::parallel_greedy() {
+        NodeID n = G->number_of_nodes();
+        states.assign(m_threads, search_state());
+
+        // pairs are applied afterwards so matching is only read in parallel,
+        // matched nodes stay claimed until then
+        #pragma omp parallel for schedule(dynamic, 1024) num_threads(m_threads)
+        for( NodeID u = 0; u < n; u++) {
+#ifdef _OPENMP
+                search_state & state = states[omp_get_thread_num()];
+#else
+                search_state & state = states[0];
+#endif
+                if( matching[u] != NOMATE || !claim(u, 1) ) continue;
+
+                bool matched = false;
+                forall_out_edges((*G), e, u) {
+                        NodeID w = G->getEdgeTarget(u, e);
+                        if( w != u && matching[w] == NOMATE && claim(w, 1) ) {
+                                state.pairs.push_back(u);
+                                state.pairs.push_back(w);
+                                matched = true;
+                                break;
+                        }
+                } endfor
+                if( !matched ) owner[u].store(0);
+        }
+
+        for( search_state & state : states ) {
+                for( size_t i = 0; i < state.pairs.size(); i += 2) {
+                        rematch(state.pairs[i], state.pairs[i+1]);
+                        matching_size++;
+                        owner[state.pairs[i]].store(0, std::memory_order_relaxed);
+                        owner[state.pairs[i+1]].store(0, std::memory_order_relaxed);
+                }
+        }
+}
+
+NodeID parallel_blossom::parallel_round(std::vector< NodeID > & roots) {
+        #pragma omp parallel for schedule(dynamic, 64) num_threads(m_threads)
+        for( size_t i = 0; i < roots.size(); i++) {
+#ifdef _OPENMP
+                NodeID thread_id = omp_get_thread_num();
+#else
+                NodeID thread_id = 0;
+#endif
+                search(roots[i], thread_id + 1, states[thread_id]);
+        }
+
+        NodeID augmentations = 0;
+        for( search_state & state : states ) {
+                augmentations += state.augmentations;
+                apply(state);
+        }
+        return augmentations;
+}
+
+void parallel_blossom::apply( search_state & state ) {
+        for( size_t i = 0; i < state.pairs.size(); i += 2) {
+                rematch(state.pairs[i], state.pairs[i+1]);
+        }
+        matching_size += state.augmentations;
+        release(state.held, 0);
+
+        state.pairs.clear();
+        state.held.clear();
+        state.augmentations = 0;
+}
+
+void parallel_blossom::search( NodeID r, NodeID owner_id, search_state & state ) {
+        // r may have been used by a path of another search in the meantime
+        if( !claim(r, owner_id) ) return;
+
+        std::vector< NodeID > & Q = state.Q;
+        std::vector< NodeID > & T = state.T;
+        Q.clear(); T.clear();
+        Q.push_back(r); T.push_back(r);
+        label[r] = EVEN;
+
+        // without conflicts a failed search proves its tree Hungarian, such
+        // a tree is never part of an augmenting path and is left out from now on
+        bool conflict = false;
+
+        for( size_t head = 0; head < Q.size(); head++) {
+                NodeID v = Q[head];
+                forall_out_edges((*G), e, v) {
+                        NodeID w = G->getEdgeTarget(v, e);
+                        NodeID w_owner = owner[w].load(std::memory_order_acquire);
+
+                        if( w_owner == owner_id ) {
+                                if( base(v) == base(w) || label[base(w)] == ODD ) 
+                                        continue; // nothing todo
+
+                                // base(w) is EVEN, i.e. a blossom
+                                NodeID hv = base(v);
+                                NodeID hw = base(w);
+
+                                state.strue++;
+                                path1[hv] = state.strue;
+                                path2[hw] = state.strue;
+
+                                while( path1[hw] != state.strue && path2[hv] != state.strue ) {
+                                        if( matching[hv] != NOMATE ) {
+                                                hv = base( pred[ matching[hv] ] );
+                                                path1[hv] = state.strue;
+                                        }
+
+                                        if( matching[hw] != NOMATE ) {
+                                                hw = base( pred[ matching[hw] ] );
+                                                path2[hw] = state.strue;
+                                        }
+                                }
+
+                                NodeID b = (path1[hw] == state.strue) ? hw : hv; //base
+                                shrink_path(b, v, w, state);
+                                shrink_path(b, w, v, state);
+                        } else if( w_owner == DEAD ) {
+                                continue;
+                        } else if( w_owner != 0 || !claim(w, owner_id) ) {
+                                conflict = true;
+                        } else {
+                                T.push_back(w);
+                                if( matching[w] == NOMATE ) {
+                                        // augmenting path w v .. r
+                                        state.P.clear();
+                                        find_path(state.P, v, r);
+                                        state.pairs.push_back(w);
+                                        state.pairs.insert(state.pairs.end(), state.P.begin(), state.P.end());
+                                        for( NodeID x : T ) {
+                                                owner[x].store(HELD, std::memory_order_relaxed);
+                                                state.held.push_back(x);
+                                        }
+                                        state.augmentations++;
+                                        return;
+                                }
+
+                                NodeID m = matching[w];
+                                if( !claim(m, owner_id) ) {
+                                        T.pop_back();
+                                        owner[w].store(0, std::memory_order_release);
+                                        conflict = true;
+                                        continue;
+                                }
+                                label[w] = ODD; pred[w] = v;
+                                label[m] = EVEN;
+                                T.push_back(m);
+                                Q.push_back(m);
+                        }
+                } endfor
+        }
+
+        release(T, conflict ? 0 : DEAD);
+}
+
+void parallel_blossom::release( std::vector< NodeID > & T, NodeID new_owner ) {
+        for( NodeID v : T ) {
+                label[v] = UNLABELED;
+                pred[v]  = UNDEFINED_NODE;
+                path1[v] = 0;
+                path2[v] = 0;
+        }
+        base.split(T);
+        for( NodeID v : T ) {
+                owner[v].store(new_owner, std::memory_order_release);
+        }
+}
+
+void parallel_blossom::shrink_path( NodeID b, NodeID v, NodeID w, search_state & state ) {
+        NodeID x = base(v);
+        while(x != b) {
+                base.union_blocks(x,b);
+                x = matching[x];
+
+                base.union_blocks(x,b);
+                base.make_rep(b);
+
+                state.Q.push_back(x);
+
+                source_bridge[x] = v; target_bridge[x] = w;
+                x = base( pred[x] );
+        }
+}
+
+void parallel_blossom::find_path( std::vector< NodeID > & P, NodeID x, NodeID y ) {
+        if ( x == y ) {
+                P.push_back(x);
+                return;
+        }
+
+        if( label[x] == EVEN ) {
+                P.push_back(x);
+                P.push_back(matching[x]);
+                find_path(P, pred[matching[x]], y);
+        } else { // x is ODD
+                P.push_back(x);
+
+                std::vector< NodeID > P3; 
+                find_path( P3, source_bridge[x], matching[x] );
+
+                std::reverse(P3.begin(), P3.end());
+                P.insert(P.end(), P3.begin(), P3.end()); // concatenate P and P3
+                find_path( P, target_bridge[x], y );
+        }
+}
@@ -0,0 +1,95 @@
+/******************************************************************************
+ * parallel_blossom.h
+ *
+ * Exact maximum matching with OpenMP. A parallel greedy pass builds the
+ * initial matching, then rounds of concurrent augmenting path searches run
+ * one Edmonds tree per free node. A search owns every node it labels
+ * (atomic claim), so concurrent trees are node disjoint and share the per
+ * node arrays without locks; an edge into a tree of another search is
+ * ignored. Found paths are applied between rounds. Once rounds stop paying
+ * off, phase_blossom finishes sequentially, so the result is maximum.
+ *
+ *****************************************************************************/
+
+#ifndef PARALLEL_BLOSSOM_H
+#define PARALLEL_BLOSSOM_H
+
+#include <atomic>
+#include <limits>
+#include <memory>
+#include <vector>
+
+#include "dyn_matching.h"
+#include "node_partition.h"
+
+class parallel_blossom final : public dyn_matching {
+        public:
+                parallel_blossom (dyn_graph_access* G, MatchConfig & config);
+                ~parallel_blossom ();
+
+                virtual bool new_edge(NodeID source, NodeID target);
+                virtual bool remove_edge(NodeID source, NodeID target);
+                virtual NodeID getMSize ();
+                virtual void postprocessing();
+                virtual void init_matching (const std::vector< NodeID > & initial_matching);
+
+                virtual void checkpoint (checkpoint_writer & writer);
+                virtual void restore (checkpoint_reader & reader);
+
+                // warm start from the given matching instead of the greedy pass
+                void init( std::vector< NodeID > & matching );
+
+        private:
+                // state of the searches of one thread
+                struct search_state {
+                        search_state() : augmentations(0), strue(0) {}
+
+                        std::vector< NodeID > Q;
+                        std::vector< NodeID > T;
+                        std::vector< NodeID > P;
+                        std::vector< NodeID > pairs; // found paths, as consecutive pairs to match
+                        std::vector< NodeID > held;  // nodes of trees that found a path
+                        NodeID                augmentations;
+                        long                  strue;
+                };
+
+                void   parallel_greedy();
+                NodeID parallel_round(std::vector< NodeID > & roots);
+                void   search( NodeID r, NodeID owner_id, search_state & state );
+                void   apply( search_state & state );
+
+                inline bool claim( NodeID v, NodeID owner_id );
+                void release( std::vector< NodeID > & T, NodeID new_owner );
+
+                void shrink_path( NodeID b, NodeID v, NodeID w, search_state & state );
+                void find_path( std::vector< NodeID > & P, NodeID x, NodeID y );
+
+                int m_threads;
+
+                // 0 if unclaimed, HELD if on a path that is applied after the round,
+                // DEAD if in a Hungarian tree, otherwise 1 + the thread whose search
+                // owns the node
+                static const NodeID HELD = std::numeric_limits< NodeID >::max();
+                static const NodeID DEAD = std::numeric_limits< NodeID >::max() - 1;
+                std::unique_ptr< std::atomic< NodeID >[] > owner;
+
+                // only the owner of a node reads or writes its entries
+                std::vector< NodeID > label;
+                std::vector< NodeID > pred;
+                std::vector< NodeID > source_bridge;
+                std::vector< NodeID > target_bridge;
+                std::vector< long >   path1;
+                std::vector< long >   path2;
+                node_partition        base;
+
+                std::vector< search_state > states;
+
+                bool initalized;
+};
+
+bool parallel_blossom::claim( NodeID v, NodeID owner_id ) {
+        NodeID expected = 0;
+        return owner[v].load(std::memory_order_relaxed) == 0 && owner[v].compare_exchange_strong(expected, owner_id);
+}
+
+#endif
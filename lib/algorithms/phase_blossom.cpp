@@ -0,0 +1,214 @@
+/******************************************************************************
+ * phase_blossom.cpp
+ *
+ *****************************************************************************/
+
+#include <algorithm>
+
+#include "phase_blossom.h"
+#include "blossom_initialization.h"
+
+phase_blossom::phase_blossom(dyn_graph_access* G, MatchConfig & match_config) : dyn_matching(G, match_config), strue(0), initalized(false) {
+        label.resize(G->number_of_nodes(), UNLABELED);
+        enable_free_vertex_index(true);
+}
+
+phase_blossom::~phase_blossom() {
+
+}
+
+bool phase_blossom::new_edge(NodeID source, NodeID target) {
+        bool added = G->new_edge(source, target);
+        G->new_edge(target, source);
+        if( added ) count_new_edge(source, target);
+        return true;
+}
+
+bool phase_blossom::remove_edge(NodeID source, NodeID target) {
+        bool removed = G->remove_edge(source, target);
+        G->remove_edge(target, source);
+        if( removed ) count_removed_edge(source, target);
+        return true;
+}
+
+NodeID phase_blossom::getMSize () {
+        return matching_size;
+}
+
+void phase_blossom::init( std::vector< NodeID > & matching_param ) {
+        forall_nodes((*G), node) {
+                NodeID m = matching_param[node];
+                if( m != NOMATE && node < m && matching[node] != m ) {
+                        if( matching[node] != NOMATE ) matching_size--;
+                        if( matching[m] != NOMATE )    matching_size--;
+                        rematch(node, m);
+                        matching_size++;
+                }
+        } endfor
+        initalized = true;
+}
+
+void phase_blossom::init_matching (const std::vector< NodeID > & initial_matching) {
+        dyn_matching::init_matching(initial_matching);
+        matching_size /= 2;
+        initalized = true;
+}
+
+// same layout as static_blossom, both run as BLOSSOM
+void phase_blossom::checkpoint (checkpoint_writer & writer) {
+        dyn_matching::checkpoint(writer);
+        writer.write_vector(label);
+        writer.write(initalized);
+}
+
+void phase_blossom::restore (checkpoint_reader & reader) {
+        dyn_matching::restore(reader);
+        reader.read_vector(label);
+        reader.read(initalized);
+        label.assign(G->number_of_nodes(), UNLABELED);
+}
+
+void phase_blossom::postprocessing() {
+        if( !initalized ) {
+                std::vector< NodeID > initial(matching);
+                blossom_initialization::initial_matching(G, config.blossom_init, initial);
+                init(initial);
+        }
+
+        NodeID n = G->number_of_nodes();
+        label.assign(n, UNLABELED);
+        pred.assign(n, UNDEFINED_NODE);
+        root.assign(n, UNDEFINED_NODE);
+        source_bridge.assign(n, UNDEFINED_NODE);
+        target_bridge.assign(n, UNDEFINED_NODE);
+        path1.assign(n, 0);
+        path2.assign(n, 0);
+        frozen.assign(n, false);
+        base.init(G);
+
+        while( phase() > 0 ) ;
+}
+
+NodeID phase_blossom::phase() {
+        // the free nodes with edges, in the order of forall_nodes
+        free_vertices.sorted(Q, true);
+        T = Q;
+        for( NodeID node : Q ) {
+                label[node] = EVEN;
+                root[node]  = node;
+        }
+
+        NodeID augmentations = 0;
+        for( size_t head = 0; head < Q.size(); head++) {
+                NodeID v = Q[head];
+
+                forall_out_edges((*G), e, v) {
+                        if( frozen[root[v]] ) break;
+
+                        NodeID w = G->getEdgeTarget(v, e);
+                        if( base(v) == base(w) || label[base(w)] == ODD ) 
+                                continue; // nothing todo
+
+                        if( label[w] == UNLABELED ) {
+                                NodeID m = matching[w];
+                                label[w] = ODD;  root[w] = root[v]; pred[w] = v;
+                                label[m] = EVEN; root[m] = root[v];
+                                Q.push_back(m);
+                                T.push_back(w);
+                                T.push_back(m);
+                        } else if( frozen[root[w]] ) {
+                                continue;
+                        } else if( root[v] != root[w] ) {
+                                augment(v, w);
+                                frozen[root[v]] = true;
+                                frozen[root[w]] = true;
+                                augmentations++;
+                                break;
+                        } else { // base(w) is EVEN in the same tree
+                                NodeID hv = base(v);
+                                NodeID hw = base(w);
+
+                                strue++;
+                                path1[hv] = strue;
+                                path2[hw] = strue;
+
+                                while( path1[hw] != strue && path2[hv] != strue ) {
+                                        if( matching[hv] != NOMATE ) {
+                                                hv = base( pred[ matching[hv] ] );
+                                                path1[hv] = strue;
+                                        }
+
+                                        if( matching[hw] != NOMATE ) {
+                                                hw = base( pred[ matching[hw] ] );
+                                                path2[hw] = strue;
+                                        }
+                                }
+
+                                NodeID b = (path1[hw] == strue) ? hw : hv; //base
+                                shrink_path(b, v, w);
+                                shrink_path(b, w, v);
+                        }
+                } endfor
+        }
+
+        for( NodeID v : T ) {
+                frozen[root[v]] = false;
+                label[v] = UNLABELED;
+                pred[v]  = UNDEFINED_NODE;
+        }
+        base.reset();
+
+        return augmentations;
+}
+
+void phase_blossom::augment( NodeID v, NodeID w ) {
+        // root(w) .. w v .. root(v)
+        P1.clear(); P2.clear();
+        find_path(P2, w, root[w]);
+        find_path(P1, v, root[v]);
+        std::reverse(P2.begin(), P2.end());
+        P2.insert(P2.end(), P1.begin(), P1.end());
+
+        for( size_t i = 0; i + 1 < P2.size(); i += 2) {
+                rematch(P2[i], P2[i+1]);
+        }
+        matching_size++;
+}
+
+void phase_blossom::shrink_path( NodeID b, NodeID v, NodeID w ) {
+        NodeID x = base(v);
+        while(x != b) {
+                base.union_blocks(x,b);
+                x = matching[x];
+
+                base.union_blocks(x,b);
+                base.make_rep(b);
+
+                Q.push_back(x);
+
+                source_bridge[x] = v; target_bridge[x] = w;
+                x = base( pred[x] );
+        }
+}
+
+void phase_blossom::find_path( std::vector< NodeID > & P, NodeID x, NodeID y ) {
+        if ( x == y ) {
+                P.push_back(x);
+                return;
+        }
+
+        if( label[x] == EVEN ) {
+                P.push_back(x);
+                P.push_back(matching[x]);
+                find_path(P, pred[matching[x]], y);
+        } else { // x is ODD
+                P.push_back(x);
+
+                std::vector< NodeID > P3; 
+                find_path( P3, source_bridge[x], matching[x] );
+
+                std::reverse(P3.begin(), P3.end());
+                P.insert(P.end(), P3.begin(), P3.end()); // concatenate P and P3
+                find_path( P, target_bridge[x], y );
+        }
+}
@@ -0,0 +1,71 @@
+/******************************************************************************
+ * phase_blossom.h
+ *
+ * Exact maximum matching that searches from all free nodes at once. Every
+ * phase grows one alternating forest rooted at all free nodes (BFS order,
+ * blossoms are shrunk as in static_blossom) and augments whenever two trees
+ * meet. Trees that took part in an augmentation are frozen for the rest of
+ * the phase, so the paths of a phase are node disjoint. A phase without an
+ * augmentation proves the matching maximum.
+ *
+ * This is not Micali-Vazirani: a phase does not restrict itself to shortest
+ * augmenting paths, so the O(m sqrt(n)) bound does not hold. In practice
+ * few phases suffice and each costs O(m alpha(n)).
+ *
+ *****************************************************************************/
+
+#ifndef PHASE_BLOSSOM_H
+#define PHASE_BLOSSOM_H
+
+#include <vector>
+
+#include "dyn_matching.h"
+#include "blossom_base.h"
+
+class phase_blossom final : public dyn_matching {
+        public:
+                phase_blossom (dyn_graph_access* G, MatchConfig & config);
+                ~phase_blossom ();
+
+                virtual bool new_edge(NodeID source, NodeID target);
+                virtual bool remove_edge(NodeID source, NodeID target);
+                virtual NodeID getMSize ();
+                virtual void postprocessing();
+                virtual void init_matching (const std::vector< NodeID > & initial_matching);
+
+                virtual void checkpoint (checkpoint_writer & writer);
+                virtual void restore (checkpoint_reader & reader);
+
+                // warm start from the given matching instead of blossom_init
+                void init( std::vector< NodeID > & matching );
+
+        private:
+                // one phase, returns the number of augmentations
+                NodeID phase();
+
+                void augment( NodeID v, NodeID w );
+                void shrink_path( NodeID b, NodeID v, NodeID w );
+                void find_path( std::vector< NodeID > & P, NodeID x, NodeID y );
+
+                std::vector< NodeID > label;
+                std::vector< NodeID > pred;
+                std::vector< NodeID > root;
+                std::vector< NodeID > source_bridge;
+                std::vector< NodeID > target_bridge;
+                std::vector< long >   path1;
+                std::vector< long >   path2;
+                long                  strue;
+
+                // frozen[r] is set once the tree rooted at r augmented in this phase
+                std::vector< bool >   frozen;
+
+                // even nodes in BFS order and all nodes labeled in this phase
+                std::vector< NodeID > Q;
+                std::vector< NodeID > T;
+                std::vector< NodeID > P1, P2;
+                blossom_base          base;
+
+                bool initalized;
+};
+
+#endif
@@ -4,9 +4,20 @@
  *
  *****************************************************************************/
 
+#include <algorithm>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 #include "rw_dyn_matching.h"
 
 rw_dyn_matching::rw_dyn_matching (dyn_graph_access* G, MatchConfig & config) : dyn_matching(G, config) {
+        m_threads = std::max(1, config.threads);
+        m_regions = 0;
+#ifndef _OPENMP
+        m_threads = 1;
+#endif
+        if( config.free_neighbor_counts ) enable_free_neighbor_counts();
         if( !config.fast_rw ) {
                 direct_new_mates.resize(G->number_of_nodes(), NOMATE);
                 this->augpath = std::vector<NodeID> (config.rw_max_length + 4, NOMATE);
@@ -14,8 +25,9 @@ rw_dyn_matching::rw_dyn_matching (dyn_graph_access* G, MatchConfig & config) : d
 }
 
 bool rw_dyn_matching::new_edge(NodeID source, NodeID target) {
-        G->new_edge(source, target);
+        bool added = G->new_edge(source, target);
         G->new_edge(target, source);
+        if( added ) count_new_edge(source, target);
 
         handle_insertion (source, target);
 
@@ -23,14 +35,431 @@ bool rw_dyn_matching::new_edge(NodeID source, NodeID target) {
 }
 
 bool rw_dyn_matching::remove_edge(NodeID source, NodeID target) {
-        G->remove_edge(source, target);
+        bool removed = G->remove_edge(source, target);
         G->remove_edge(target, source);
+        if( removed ) count_removed_edge(source, target);
 
         handle_deletion(source, target);
 
         return true;
 }
 
+void rw_dyn_matching::remove_edges(const std::vector< std::pair< NodeID, NodeID > > & edges) {
+        if( config.fast_rw ) {
+                dyn_matching::remove_edges(edges);
+                return;
+        }
+
+        batch_roots.clear();
+        for( size_t i = 0; i < edges.size(); i++) {
+                NodeID source = edges[i].first;
+                NodeID target = edges[i].second;
+                bool removed = G->remove_edge(source, target);
+                G->remove_edge(target, source);
+                if( removed ) count_removed_edge(source, target);
+
+                if (is_matched(source, target)) {
+                        unmatch(source, target);
+                        batch_roots.push_back(source);
+                        batch_roots.push_back(target);
+                }
+        }
+        repair_batch(batch_roots);
+}
+
+// Rounds of concurrent walks from the free roots. A walk owns every node it
+// visits (atomic claim), so concurrent walks are node disjoint and the
+// matching is only read during a round. A walk that runs into a node of
+// another walk gives its nodes up and is retried in the next round. Found
+// paths keep their nodes until they are applied after the round, so each
+// one is applied as a whole or not at all. Roots that still conflict after
+// a few rounds are repaired by one thread, so are batches too small to pay
+// for a parallel round
+void rw_dyn_matching::repair_batch( std::vector< NodeID > & roots ) {
+        const int    MAX_ROUNDS     = 8;
+        const size_t MIN_PER_THREAD = 64;
+
+        if( !owner ) {
+                NodeID n = G->number_of_nodes();
+                owner.reset(new std::atomic< NodeID >[n]);
+                for( NodeID v = 0; v < n; v++) owner[v].store(0, std::memory_order_relaxed);
+        }
+
+        if( m_threads == 1 || roots.size() < MIN_PER_THREAD * m_threads ) {
+                interleaved_repair(roots);
+                return;
+        }
+        states.resize(m_threads);
+
+        for( int round = 0; round < MAX_ROUNDS && !roots.empty(); round++) {
+                random_functions::split(streams, m_threads, m_regions++);
+
+                #pragma omp parallel num_threads(m_threads)
+                {
+#ifdef _OPENMP
+                        NodeID thread_id = omp_get_thread_num();
+#else
+                        NodeID thread_id = 0;
+#endif
+                        walk_state & state = states[thread_id];
+                        random_functions::stream_scope scope(streams[thread_id]);
+
+                        #pragma omp for schedule(dynamic, 16)
+                        for( size_t i = 0; i < roots.size(); i++) {
+                                NodeID w = roots[i];
+                                if( !is_free(w) ) continue;
+
+                                walk_result result = WALK_FAILED;
+                                for( unsigned long long j = 0; j < config.rw_repetitions_per_node && result == WALK_FAILED; j++) {
+                                        result = claim_walk(w, thread_id + 1, state);
+                                }
+                                if( result == WALK_CONFLICT ) state.retry.push_back(w);
+                        }
+                }
+
+                roots.clear();
+                for( walk_state & state : states ) {
+                        apply(state);
+                        for( NodeID w : state.retry ) {
+                                if( is_free(w) ) roots.push_back(w);
+                        }
+                        state.retry.clear();
+                }
+        }
+
+        interleaved_repair(roots);
+}
+
+// A group of --rw_walk_group walks advances in turns. Every turn of a walk
+// needs one random memory access: the adjacency array of its node, the
+// chosen slot, then owner, mate and direct_new_mates of the target, then the
+// owner of the mate. Each is prefetched one turn ahead, so the cache misses
+// of the walks of a group overlap instead of adding up. The walks claim
+// their nodes like the concurrent ones, a found path is applied right away
+// since other walks only read the matching of nodes they own. A walk that
+// runs into another one is repeated after the group has finished. With a
+// group of one walk this is cs_random_walk for every root, which a group
+// of 0 runs directly
+void rw_dyn_matching::interleaved_repair( std::vector< NodeID > & roots ) {
+        if( config.rw_walk_group <= 0 ) {
+                sequential_repair(roots);
+                return;
+        }
+        const NodeID group = config.rw_walk_group;
+        std::vector< walk_cursor > & cursors = walk_cursors;
+        cursors.resize(group);
+
+        std::vector< NodeID > retry;
+        size_t next_root = 0;
+        NodeID active    = 0;
+        random_functions::stream & rng = random_functions::get_stream();
+
+        // (re)starts the walk of cursor c at its root, or at the next root
+        auto start = [&](walk_cursor & c, NodeID owner_id, bool next) {
+                while( true ) {
+                        if( next ) {
+                                if( next_root == roots.size() ) { c.stage = IDLE; return; }
+                                c.root       = roots[next_root++];
+                                c.repetition = 0;
+                                if( !is_free(c.root) ) continue;
+                        }
+                        c.state.path.clear();
+                        c.state.claimed.clear();
+                        if( !own(c.root, owner_id, c.state) ) {
+                                retry.push_back(c.root);
+                                next = true;
+                                continue;
+                        }
+                        c.state.path.push_back(c.root);
+                        c.u     = c.root;
+                        c.t     = c.root;
+                        c.step  = 0;
+                        c.stage = SLOT;
+                        G->prefetch_node(c.u);
+                        return;
+                }
+        };
+
+        // ends the current walk of cursor c
+        auto finish = [&](walk_cursor & c, NodeID owner_id, walk_result result) {
+                walk_state & state = c.state;
+                if( result == WALK_FAILED && config.rw_ending_additional_settle ) {
+                        NodeID v;
+                        if( claim_free(c.u, v, c.root, owner_id, state) ) {
+                                state.path.push_back(v);
+                                result = WALK_FOUND;
+                        }
+                }
+                for( NodeID x : state.claimed ) {
+                        direct_new_mates[x] = NOMATE;
+                }
+                if( result == WALK_FOUND ) {
+                        commit_path(state.path);
+                }
+                for( NodeID x : state.claimed ) {
+                        owner[x].store(0, std::memory_order_relaxed);
+                }
+
+                if( result == WALK_CONFLICT ) {
+                        retry.push_back(c.root);
+                        start(c, owner_id, true);
+                } else if( result == WALK_FAILED && ++c.repetition < config.rw_repetitions_per_node ) {
+                        start(c, owner_id, false);
+                } else {
+                        start(c, owner_id, true);
+                }
+        };
+
+        for( NodeID k = 0; k < group; k++) {
+                start(cursors[k], k + 1, true);
+                if( cursors[k].stage != IDLE ) active++;
+        }
+
+        while( active > 0 ) {
+                for( NodeID k = 0; k < group; k++) {
+                        walk_cursor & c = cursors[k];
+                        NodeID owner_id = k + 1;
+                        switch( c.stage ) {
+                                case IDLE:
+                                        continue;
+                                case SLOT: {
+                                        if( c.step >= config.rw_max_length ) {
+                                                finish(c, owner_id, WALK_FAILED);
+                                                break;
+                                        }
+                                        if( config.rw_low_degree_settle && G->getNodeDegree(c.u) < config.rw_low_degree_value ) {
+                                                NodeID v;
+                                                if( claim_free(c.u, v, c.root, owner_id, c.state) ) {
+                                                        c.state.path.push_back(v);
+                                                        finish(c, owner_id, WALK_FOUND);
+                                                        break;
+                                                }
+                                        }
+                                        EdgeID max_index = G->get_first_invalid_edge(c.u);
+                                        if( max_index <= 0 ) {
+                                                finish(c, owner_id, WALK_FAILED);
+                                                break;
+                                        }
+                                        c.e = rng.bounded(max_index);
+                                        G->prefetch_edge(c.u, c.e);
+                                        c.stage = TARGET;
+                                        } break;
+                                case TARGET: {
+                                        EdgeID max_index = G->get_first_invalid_edge(c.u);
+                                        c.v = G->getEdgeTarget(c.u, c.e);
+                                        if( c.v == c.t || c.v == c.root ) {
+                                                if( !surrogate(c.u, c.e, max_index, {c.t, c.root}) ) {
+                                                        finish(c, owner_id, WALK_FAILED);
+                                                        break;
+                                                }
+                                                c.v = G->getEdgeTarget(c.u, c.e);
+                                        }
+                                        PREFETCH(&owner[c.v]);
+                                        PREFETCH(&matching[c.v]);
+                                        PREFETCH(&direct_new_mates[c.v]);
+                                        c.stage = MATE;
+                                        } break;
+                                case MATE: {
+                                        if( !own(c.v, owner_id, c.state) ) {
+                                                finish(c, owner_id, WALK_CONFLICT);
+                                                break;
+                                        }
+                                        if( _rw_is_freecs(c.v) ) {
+                                                c.state.path.push_back(c.v);
+                                                finish(c, owner_id, WALK_FOUND);
+                                                break;
+                                        }
+                                        c.w = direct_new_mates[c.v] == NOMATE ? mate(c.v) : direct_new_mates[c.v];
+                                        PREFETCH(&owner[c.w]);
+                                        G->prefetch_node(c.w);
+                                        c.stage = CLAIM_MATE;
+                                        } break;
+                                case CLAIM_MATE: {
+                                        if( !own(c.w, owner_id, c.state) ) {
+                                                finish(c, owner_id, WALK_CONFLICT);
+                                                break;
+                                        }
+                                        c.state.path.push_back(c.v);
+                                        c.state.path.push_back(c.w);
+
+                                        direct_new_mates[c.u] = c.v;
+                                        direct_new_mates[c.v] = c.u;
+                                        direct_new_mates[c.w] = c.w;
+
+                                        c.u     = c.w;
+                                        c.t     = c.v;
+                                        c.step += 2;
+                                        c.stage = SLOT;
+                                        } break;
+                        }
+                        if( c.stage == IDLE ) active--;
+                }
+        }
+
+        sequential_repair(retry);
+}
+
+// handle_deletion for every root
+void rw_dyn_matching::sequential_repair( std::vector< NodeID > & roots ) {
+        for( NodeID w : roots ) {
+                if( !is_free(w) ) continue;
+
+                unsigned long long i = 0;
+                size_t length = 0;
+                bool augpath_found = false;
+                while (i < config.rw_repetitions_per_node && !augpath_found) {
+                        augpath_found = cs_random_walk(w, augpath, length);
+                        i++;
+                }
+                if (augpath_found) {
+                        resolve_augpath(augpath, length);
+                }
+        }
+}
+
+// cs_random_walk_t on claimed nodes
+rw_dyn_matching::walk_result rw_dyn_matching::claim_walk( NodeID start, NodeID owner_id, walk_state & state ) {
+        std::vector< NodeID > & path    = state.path;
+        std::vector< NodeID > & claimed = state.claimed;
+        path.clear();
+        claimed.clear();
+        if( !own(start, owner_id, state) ) return WALK_CONFLICT;
+
+        walk_result result = WALK_FAILED;
+        int step = 0;
+        NodeID u = start;
+        NodeID t = start;
+        random_functions::stream & rng = random_functions::get_stream();
+
+        path.push_back(u);
+        while (step < config.rw_max_length) {
+                if( config.rw_low_degree_settle && G->getNodeDegree(u) < config.rw_low_degree_value ) {
+                        NodeID v;
+                        if( claim_free(u, v, start, owner_id, state) ) {
+                                path.push_back(v);
+                                result = WALK_FOUND;
+                                break;
+                        }
+                }
+
+                EdgeID max_index = G->get_first_invalid_edge(u);
+                if (max_index <= 0) break;
+
+                EdgeID new_matching_edge = rng.bounded(max_index);
+                NodeID v = G->getEdgeTarget(u, new_matching_edge);
+                if (v == t || v == start) {
+                        if( !surrogate(u, new_matching_edge, max_index, {t, start}) ) break;
+                        v = G->getEdgeTarget(u, new_matching_edge);
+                }
+
+                if( !own(v, owner_id, state) ) {
+                        result = WALK_CONFLICT;
+                        break;
+                }
+                if( _rw_is_freecs(v) ) {
+                        path.push_back(v);
+                        result = WALK_FOUND;
+                        break;
+                }
+
+                NodeID w = direct_new_mates[v] == NOMATE ? mate(v) : direct_new_mates[v];
+                if( !own(w, owner_id, state) ) {
+                        result = WALK_CONFLICT;
+                        break;
+                }
+                path.push_back(v);
+                path.push_back(w);
+
+                direct_new_mates[u] = v;
+                direct_new_mates[v] = u;
+                direct_new_mates[w] = w;
+
+                u = w;
+                t = v;
+                step += 2;
+        }
+
+        if( result == WALK_FAILED && config.rw_ending_additional_settle ) {
+                NodeID v;
+                if( claim_free(u, v, start, owner_id, state) ) {
+                        path.push_back(v);
+                        result = WALK_FOUND;
+                }
+        }
+
+        for( NodeID x : claimed ) {
+                direct_new_mates[x] = NOMATE;
+        }
+        if( result == WALK_FOUND ) {
+                for( size_t i = 0; i + 1 < path.size(); i += 2) {
+                        state.pairs.push_back(path[i]);
+                        state.pairs.push_back(path[i+1]);
+                }
+                for( NodeID x : claimed ) {
+                        owner[x].store(HELD, std::memory_order_relaxed);
+                        state.held.push_back(x);
+                }
+        } else {
+                for( NodeID x : claimed ) {
+                        owner[x].store(0, std::memory_order_release);
+                }
+        }
+        return result;
+}
+
+// find_free on claimed nodes, the free neighbor v is claimed
+bool rw_dyn_matching::claim_free( NodeID u, NodeID & v, NodeID start, NodeID owner_id, walk_state & state ) {
+        // as in find_free, the matching does not change during a walk
+        if( m_count_free_neighbors && !free_neighbors.any(u) ) return false;
+
+        EdgeID deg_u = G->getNodeDegree(u);
+        for (EdgeID i = 0; i < deg_u; ++i) {
+                v = G->getEdgeTarget(u, i);
+                if (v == start) continue;
+
+                if( owner[v].load(std::memory_order_relaxed) == owner_id ) {
+                        if( _rw_is_freecs(v) ) return true;
+                } else if( is_free(v) && claim(v, owner_id) ) {
+                        state.claimed.push_back(v);
+                        return true;
+                }
+        }
+        return false;
+}
+
+// matching_size counts matched nodes, a walk that revisited nodes may
+// rematch a node twice so it is counted per pair
+void rw_dyn_matching::commit_pair( NodeID u, NodeID v ) {
+        if( matching[u] == v ) return;
+
+        for( NodeID x : {u, v} ) {
+                NodeID old = matching[x];
+                if( old == NOMATE )             matching_size++;
+                else if( matching[old] == x )   matching_size--;
+        }
+        rematch(u, v);
+}
+
+// an augmenting path found by a walk, see resolve_augpath
+void rw_dyn_matching::commit_path( const std::vector< NodeID > & path ) {
+        for( size_t i = 0; i + 1 < path.size(); i += 2) {
+                commit_pair(path[i], path[i+1]);
+        }
+}
+
+// the paths of a round are node disjoint, their pairs are matched one after the other
+void rw_dyn_matching::apply( walk_state & state ) {
+        for( size_t i = 0; i < state.pairs.size(); i += 2) {
+                commit_pair(state.pairs[i], state.pairs[i+1]);
+        }
+        for( NodeID x : state.held ) {
+                owner[x].store(0, std::memory_order_relaxed);
+        }
+
+        state.pairs.clear();
+        state.held.clear();
+}
+
 void rw_dyn_matching::handle_insertion (NodeID source, NodeID target) {
         // check whether the vertices are free. if so, add to the matching
         if (is_free(source) && is_free(target)) {
@@ -81,9 +510,7 @@ bool rw_dyn_matching::fast_random_walk (NodeID start) {
 
                 if( matching[v] != NOMATE ) {
                         NodeID old_match = matching[v];
-                        matching[ u ] = v;
-                        matching[ v ] = u;
-                        matching[ old_match ] = NOMATE;
+                        rematch(u, v); // frees old_match
                         u = old_match;
                 }
                 steps += 2;
@@ -138,6 +565,20 @@ bool rw_dyn_matching::cs_random_walk (NodeID start, std::vector<NodeID>& augpath
 }
 
 bool rw_dyn_matching::cs_random_walk (NodeID start, std::vector<NodeID>& augpath, size_t& length, std::pair<NodeID, NodeID> avoid) {
+        if( config.rw_low_degree_settle ) {
+                if( config.rw_ending_additional_settle ) {
+                        return cs_random_walk_t< true, true >(start, augpath, length, avoid);
+                }
+                return cs_random_walk_t< true, false >(start, augpath, length, avoid);
+        }
+        if( config.rw_ending_additional_settle ) {
+                return cs_random_walk_t< false, true >(start, augpath, length, avoid);
+        }
+        return cs_random_walk_t< false, false >(start, augpath, length, avoid);
+}
+
+template< bool LOW_DEGREE_SETTLE, bool ENDING_SETTLE >
+bool rw_dyn_matching::cs_random_walk_t (NodeID start, std::vector<NodeID>& augpath, size_t& length, std::pair<NodeID, NodeID> avoid) {
         int step = 0;
         length = 0;
         
@@ -149,10 +590,11 @@ bool rw_dyn_matching::cs_random_walk (NodeID start, std::vector<NodeID>& augpath
 
         augpath[length++] = u;
         std::vector< NodeID > set_to_notmate;
+        random_functions::stream & rng = random_functions::get_stream();
 
         // perform random walk until break condition is met
         while (step < config.rw_max_length) {
-                if( config.rw_low_degree_settle ) {
+                if( LOW_DEGREE_SETTLE ) {
                         if (G->getNodeDegree(u) < config.rw_low_degree_value) {
                                 NodeID v;
 
@@ -171,7 +613,7 @@ bool rw_dyn_matching::cs_random_walk (NodeID start, std::vector<NodeID>& augpath
                 if (max_index <= 0) break;
 
                 // randomly choose a vertex v from N(u)
-                EdgeID new_matching_edge = random_functions::nextInt(0, max_index-1);
+                EdgeID new_matching_edge = rng.bounded(max_index);
                 NodeID v = G->getEdgeTarget(u, new_matching_edge);
 
                 if (v == t || v == s) { // we don't want to go back to vertex t, therefore we choose a surrogate in this case
@@ -220,7 +662,7 @@ bool rw_dyn_matching::cs_random_walk (NodeID start, std::vector<NodeID>& augpath
         }
 
         if (!augpath_found) {
-                if( config.rw_ending_additional_settle ) {
+                if( ENDING_SETTLE ) {
                         NodeID v;
 
                         // if no augmenting path was found, we perform a linear search
@@ -313,26 +755,12 @@ bool rw_dyn_matching::_rw_is_freecs(NodeID u) {
 
 
 bool rw_dyn_matching::find_free (NodeID u, NodeID& v, NodeID t) {
-        EdgeID deg_u = G->getNodeDegree(u);
-        bool mate_found = false;
-
-        for (EdgeID i = 0; i < deg_u; ++i) {
-                v = G->getEdgeTarget(u, i);
-
-                // if v is t, which is the node we want to ignore, we continue searching
-                // since we search linearily, we can be sure, that no node before t was
-                // free
-                if (v == t) {
-                        continue;
-                }
-
-                if (_rw_is_freecs(v)) {
-                        mate_found = true;
-                        break;
-                }
-        }
+        // apart from t, which is skipped anyway, the neighbors of the current
+        // node u of a walk are free with direct_new_mates iff they are free,
+        // so the scan reads the matching itself
+        if( m_count_free_neighbors && !free_neighbors.any(u) ) return false;
 
-        return mate_found;
+        return free_neighbor(u, t, v);
 }
 
 
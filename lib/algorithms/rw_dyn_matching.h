@@ -7,6 +7,7 @@
 #ifndef RW_DYN_MATCHING_H
 #define RW_DYN_MATCHING_H
 
+#include <atomic>
 #include <bitset>
 #include <cassert>
 #include <iostream>
@@ -14,19 +15,25 @@
 #include <random>
 #include <chrono>
 #include <cmath>
+#include <limits>
+#include <memory>
 
 #include "dyn_matching.h"
 #include "tools/random_functions.h"
 #include "tools/timer.h"
 #include "tools/misc.h"
 
-class rw_dyn_matching : public dyn_matching {
+class rw_dyn_matching final : public dyn_matching {
         public:
                 rw_dyn_matching (dyn_graph_access* G, MatchConfig & config); 
 
                 virtual bool new_edge(NodeID source, NodeID target);
                 virtual bool remove_edge(NodeID source, NodeID target);
 
+                // removes all edges first and then repairs the freed nodes with
+                // concurrent walks on --threads threads, see repair_batch
+                virtual void remove_edges(const std::vector< std::pair< NodeID, NodeID > > & edges);
+
                 
         protected:
                 virtual void handle_insertion (NodeID source, NodeID target);
@@ -37,6 +44,12 @@ class rw_dyn_matching : public dyn_matching {
                 bool cs_random_walk (NodeID start, std::vector<NodeID>& augpath, size_t& length, NodeID avoid);
                 
                 virtual bool cs_random_walk (NodeID start, std::vector<NodeID>& augpath, size_t& length, std::pair<NodeID, NodeID> avoid);
+
+                // the walk itself, specialized at compile time on rw_low_degree_settle
+                // and rw_ending_additional_settle so that the step loop has no
+                // configuration checks left
+                template< bool LOW_DEGREE_SETTLE, bool ENDING_SETTLE >
+                bool cs_random_walk_t (NodeID start, std::vector<NodeID>& augpath, size_t& length, std::pair<NodeID, NodeID> avoid);
                 virtual void resolve_augpath(const std::vector<NodeID>& augpath, const size_t& length);
                 
                 virtual bool break_rw (int step);
@@ -46,6 +59,75 @@ class rw_dyn_matching : public dyn_matching {
 
                 std::vector< NodeID > direct_new_mates;
                 std::vector< NodeID > augpath;
+
+        private:
+                enum walk_result { WALK_FOUND, WALK_FAILED, WALK_CONFLICT };
+
+                // state of the walks of one thread in a batch repair
+                struct walk_state {
+                        std::vector< NodeID > path;
+                        std::vector< NodeID > claimed; // nodes of the current walk
+                        std::vector< NodeID > pairs;   // found paths, as consecutive pairs to match
+                        std::vector< NodeID > held;    // nodes of found paths
+                        std::vector< NodeID > retry;   // roots whose walk ran into another walk
+                };
+
+                // a walk of interleaved_repair, stage is the memory access of its next turn
+                enum walk_stage { IDLE, SLOT, TARGET, MATE, CLAIM_MATE };
+                struct walk_cursor {
+                        walk_cursor() : stage(IDLE) {}
+
+                        walk_stage         stage;
+                        NodeID             root;
+                        NodeID             u;
+                        NodeID             t;
+                        NodeID             v;
+                        NodeID             w;
+                        EdgeID             e;
+                        int                step;
+                        unsigned long long repetition;
+                        walk_state         state;
+                };
+
+                void        repair_batch( std::vector< NodeID > & roots );
+                void        sequential_repair( std::vector< NodeID > & roots );
+                void        interleaved_repair( std::vector< NodeID > & roots );
+                walk_result claim_walk( NodeID start, NodeID owner_id, walk_state & state );
+                bool        claim_free( NodeID u, NodeID & v, NodeID start, NodeID owner_id, walk_state & state );
+                void        apply( walk_state & state );
+                void        commit_path( const std::vector< NodeID > & path );
+                void        commit_pair( NodeID u, NodeID v );
+
+                inline bool claim( NodeID v, NodeID owner_id );
+                inline bool own( NodeID v, NodeID owner_id, walk_state & state );
+
+                int m_threads;
+                // parallel rounds so far, the region of their random streams
+                uint32_t m_regions;
+
+                // 0 if unclaimed, HELD if on a path that is applied after the round,
+                // otherwise 1 + the thread whose walk owns the node. Only the owner
+                // of a node reads or writes its direct_new_mates entry
+                static const NodeID HELD = std::numeric_limits< NodeID >::max();
+                std::unique_ptr< std::atomic< NodeID >[] > owner;
+
+                std::vector< walk_state >               states;
+                std::vector< walk_cursor >              walk_cursors;
+                std::vector< random_functions::stream > streams;
+                std::vector< NodeID >                   batch_roots;
 };
 
+bool rw_dyn_matching::claim( NodeID v, NodeID owner_id ) {
+        NodeID expected = 0;
+        return owner[v].load(std::memory_order_relaxed) == 0 && owner[v].compare_exchange_strong(expected, owner_id);
+}
+
+// v belongs to the current walk afterwards, false if it belongs to another one
+bool rw_dyn_matching::own( NodeID v, NodeID owner_id, walk_state & state ) {
+        if( owner[v].load(std::memory_order_relaxed) == owner_id ) return true;
+        if( !claim(v, owner_id) ) return false;
+        state.claimed.push_back(v);
+        return true;
+}
+
 #endif // RW_DYN_MATCHING_H
@@ -3,10 +3,12 @@
 
 #include <algorithm>
 #include "static_blossom.h"
-#include "node_partition.h"
+#include "blossom_initialization.h"
+#include "blossom_base.h"
 
 static_blossom::static_blossom(dyn_graph_access* G, MatchConfig & match_config) : dyn_matching(G, match_config), initalized(false) {
-        label.resize(G->number_of_nodes()); 
+        state.resize(G->number_of_nodes()); 
+        enable_free_vertex_index(true);
 }
 
 static_blossom::~static_blossom() {
@@ -14,30 +16,30 @@ static_blossom::~static_blossom() {
 }
 
 bool static_blossom::new_edge(NodeID source, NodeID target) {
-        G->new_edge(source, target);
+        bool added = G->new_edge(source, target);
         G->new_edge(target, source);
+        if( added ) count_new_edge(source, target);
         return true;
 }
 
 bool static_blossom::remove_edge(NodeID source, NodeID target) {
-        G->remove_edge(source, target);
+        bool removed = G->remove_edge(source, target);
         G->remove_edge(target, source);
+        if( removed ) count_removed_edge(source, target);
         return true;
 }
 
 void static_blossom::init( std::vector< NodeID > & matching_param ) {
-        pred.resize(G->number_of_nodes()); 
         forall_nodes((*G), node) {
-                label[node] = EVEN; // can be EVEN, ODD, or UNLABELED
-                pred[node]  = UNDEFINED_NODE;
+                state[node].label = EVEN; // can be EVEN, ODD, or UNLABELED
+                state[node].pred  = UNDEFINED_NODE;
         } endfor
 
         forall_nodes((*G), node) {
                 if( matching_param[node] != NOMATE) {
-                        matching[node] = matching_param[node];
-                        matching[matching_param[node]] = node;
-                        label[node] = UNLABELED;
-                        label[matching_param[node]] = UNLABELED;
+                        rematch(node, matching_param[node]);
+                        state[node].label = UNLABELED;
+                        state[matching_param[node]].label = UNLABELED;
                         matching_size++;
                 }
         } endfor
@@ -45,13 +47,37 @@ void static_blossom::init( std::vector< NodeID > & matching_param ) {
         initalized = true;
 }
 
+void static_blossom::init_matching (const std::vector< NodeID > & initial_matching) {
+        dyn_matching::init_matching(initial_matching);
+        matching_size /= 2;
+
+        state.resize(G->number_of_nodes());
+        forall_nodes((*G), node) {
+                state[node].label = is_free(node) ? EVEN : UNLABELED;
+        } endfor
+        initalized = true;
+}
+
+void static_blossom::checkpoint (checkpoint_writer & writer) {
+        dyn_matching::checkpoint(writer);
+        writer.write_vector(state);
+        writer.write(initalized);
+}
+
+void static_blossom::restore (checkpoint_reader & reader) {
+        dyn_matching::restore(reader);
+        reader.read_vector(state);
+        reader.read(initalized);
+        state.resize(G->number_of_nodes());
+}
+
 void static_blossom::postprocessing() {
-        pred.resize(G->number_of_nodes()); 
-        node_partition base(G);
+        blossom_base base(G);
 
-        long strue = 0;
-        std::vector< long > path1(G->number_of_nodes(),0);
-        std::vector< long > path2(G->number_of_nodes(),0);
+        uint32_t strue = 0;
+        forall_nodes((*G), node) {
+                state[node].stamp = 0;
+        } endfor
 
         std::vector< NodeID > source_bridge(G->number_of_nodes(),UNDEFINED_NODE);
         std::vector< NodeID > target_bridge(G->number_of_nodes(),UNDEFINED_NODE);
@@ -62,27 +88,27 @@ void static_blossom::postprocessing() {
                 // else v was collapsed into base[v]
                 // {base(v) | v \in V} is the node set of G'
                 // and edge {v,w} represents an edge {base(v), base(w)} in G'
+                std::vector< NodeID > initial(matching);
+                blossom_initialization::initial_matching(G, config.blossom_init, initial);
+
                 forall_nodes((*G), node) {
-                        label[node] = EVEN; // can be EVEN, ODD, or UNLABELED
-                        pred[node]  = UNDEFINED_NODE;
+                        if( initial[node] != matching[node] && node < initial[node] ) {
+                                rematch(node, initial[node]);
+                                matching_size++;
+                        }
                 } endfor
 
                 forall_nodes((*G), node) {
-                        if( matching[node] == NOMATE ) {
-                                forall_out_edges((*G), e, node) {
-                                        NodeID target = G->getEdgeTarget(node, e);
-                                        if( node != target && matching[target] == NOMATE) {
-                                                matching[node] = target; matching[target] = node;
-                                                label[node] = UNLABELED; label[target] = UNLABELED;
-                                                matching_size++;
-                                                break;
-                                        }
-                                } endfor
-                        }
+                        state[node].label = is_free(node) ? EVEN : UNLABELED; // can be EVEN, ODD, or UNLABELED
+                        state[node].pred  = UNDEFINED_NODE;
                 } endfor
         }
 
-        forall_nodes((*G), node) {
+        // isolated nodes are no roots. the loop only matches nodes, so it visits
+        // the nodes free at its start and skips those matched meanwhile
+        std::vector< NodeID > roots;
+        free_vertices.sorted(roots, true);
+        for( NodeID node : roots ) {
                 if( matching[node] != NOMATE) continue;
 
                 std::queue< NodeID > Q; Q.push(node);
@@ -97,14 +123,14 @@ void static_blossom::postprocessing() {
                         // assume v is even node
                         forall_out_edges((*G), e, v) {
                                 NodeID w = G->getEdgeTarget(v, e);
-                                if( base(v) == base(w) || label[base(w)] == ODD) 
+                                if( base(v) == base(w) || state[base(w)].label == ODD) 
                                         continue; // nothing todo
-                                if( label[w] == UNLABELED ) {
-                                        label[w] = ODD; 
+                                if( state[w].label == UNLABELED ) {
+                                        state[w].label = ODD; 
                                         T.push_back(w);
 
-                                        pred[w] = v;
-                                        label[matching[w]] = EVEN; 
+                                        state[w].pred = v;
+                                        state[matching[w]].label = EVEN; 
 
                                         T.push_back(matching[w]);
                                         Q.push(matching[w]);
@@ -112,25 +138,25 @@ void static_blossom::postprocessing() {
                                         NodeID hv = base(v);
                                         NodeID hw = base(w);
 
-                                        strue++;
-                                        path1[hv] = strue;
-                                        path2[hw] = strue;
+                                        next_path_stamp(state, strue);
+                                        state[hv].mark_path1(strue);
+                                        state[hw].mark_path2(strue);
 
-                                        while( (path1[hw] != strue && path2[hv] != strue) && (matching[hv] != NOMATE || matching[hw] != NOMATE) ) {
+                                        while( (!state[hw].on_path1(strue) && !state[hv].on_path2(strue)) && (matching[hv] != NOMATE || matching[hw] != NOMATE) ) {
                                                 if( matching[hv] != NOMATE ) {
-                                                        hv = base( pred[ matching[hv] ] );
-                                                        path1[hv] = strue;
+                                                        hv = base( state[ matching[hv] ].pred );
+                                                        state[hv].mark_path1(strue);
                                                 }
 
                                                 if( matching[hw] != NOMATE ) {
-                                                        hw = base( pred[ matching[hw] ] );
-                                                        path2[hw] = strue;
+                                                        hw = base( state[ matching[hw] ].pred );
+                                                        state[hw].mark_path2(strue);
                                                 }
                                         }
 
-                                        if( path1[ hw ] == strue || path2[ hv ] == strue ) {
+                                        if( state[ hw ].on_path1(strue) || state[ hv ].on_path2(strue) ) {
                                                 // shrink blossom
-                                                NodeID b = (path1[hw] == strue) ? hw : hv; //base
+                                                NodeID b = state[hw].on_path1(strue) ? hw : hv; //base
                                                 shrink_path(b,v,w, base, source_bridge, target_bridge, Q);
                                                 shrink_path(b,w,v, base, source_bridge, target_bridge, Q);
                                         } else {
@@ -145,14 +171,13 @@ void static_blossom::postprocessing() {
                                                         NodeID a = P.back(); P.pop_back();
                                                         NodeID b = P.back(); P.pop_back();
 
-                                                        matching[a] = b;
-                                                        matching[b] = a;
+                                                        rematch(a, b);
                                                 }
                                                 T.push_back(w);
                                                 for( unsigned i = 0; i < T.size(); i++) {
-                                                        label[T[i]] = UNLABELED;
+                                                        state[T[i]].label = UNLABELED;
                                                 }
-                                                base.split(T);
+                                                base.reset();
                                                 breakthrough = true;
                                                 matching_size++;
                                                 break;
@@ -162,14 +187,14 @@ void static_blossom::postprocessing() {
                         } endfor
                 }
                 //std::cout <<  "run for " <<  count  << std::endl;
-        } endfor
+        }
 }
 
 NodeID  static_blossom::getMSize () {
         return matching_size; 
 }
 
-void static_blossom::shrink_path( NodeID b, NodeID v, NodeID w, node_partition & base, std::vector< NodeID > & source_bridge, std::vector< NodeID > & target_bridge, std::queue< NodeID > & Q) {
+void static_blossom::shrink_path( NodeID b, NodeID v, NodeID w, blossom_base & base, std::vector< NodeID > & source_bridge, std::vector< NodeID > & target_bridge, std::queue< NodeID > & Q) {
         // Note we are working in x prime (so node can be blossoms by itself
         NodeID x = base(v);
         while(x != b) {
@@ -182,7 +207,7 @@ void static_blossom::shrink_path( NodeID b, NodeID v, NodeID w, node_partition &
                 Q.push(x);
 
                 source_bridge[x] = v; target_bridge[x] = w;
-                x = base( pred[x] );
+                x = base( state[x].pred );
         }
 }
 
@@ -193,10 +218,10 @@ void static_blossom::find_path( std::vector< NodeID > & P, NodeID x, NodeID y, s
                 return;
         }
 
-        if( label[x] == EVEN ) {
+        if( state[x].label == EVEN ) {
                 P.push_back(x);
                 P.push_back(matching[x]);
-                find_path(P, pred[matching[x]], y, source_bridge, target_bridge);
+                find_path(P, state[matching[x]].pred, y, source_bridge, target_bridge);
                 return;
         } else { // x is ODD
                 P.push_back(x);
@@ -19,9 +19,10 @@
 #include "tools/timer.h"
 #include "data_structure/union_find.h"
 #include "tools/misc.h"
-#include "node_partition.h"
+#include "blossom_base.h"
+#include "blossom_node.h"
 
-class static_blossom : public dyn_matching {
+class static_blossom final : public dyn_matching {
         public:
                 static_blossom (dyn_graph_access* G, MatchConfig & config); 
                 ~static_blossom (); 
@@ -30,13 +31,16 @@ class static_blossom : public dyn_matching {
                 virtual bool remove_edge(NodeID source, NodeID target);
                 virtual NodeID getMSize ();
                 virtual void postprocessing();
+                virtual void init_matching (const std::vector< NodeID > & initial_matching);
+
+                virtual void checkpoint (checkpoint_writer & writer);
+                virtual void restore (checkpoint_reader & reader);
                 
-                void shrink_path( NodeID b, NodeID v, NodeID w, node_partition & base, std::vector< NodeID > & source_bridge, std::vector< NodeID > & target_bridge, std::queue< NodeID > & Q);
+                void shrink_path( NodeID b, NodeID v, NodeID w, blossom_base & base, std::vector< NodeID > & source_bridge, std::vector< NodeID > & target_bridge, std::queue< NodeID > & Q);
                 void find_path( std::vector< NodeID > & P, NodeID x, NodeID y, std::vector< NodeID > & source_bridge, std::vector< NodeID > & target_bridge);
                 void init( std::vector< NodeID > & matching );
         private:
-                std::vector< NodeID > label;
-                std::vector< NodeID > pred;
+                std::vector< blossom_node > state;
                 bool initalized;
 
 };
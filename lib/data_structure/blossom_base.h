@@ -0,0 +1,114 @@
+/******************************************************************************
+ * blossom_base.h 
+ *
+ * Union-find over the nodes that maps every node to the base of the blossom
+ * it was shrunk into. Parent, rank and a generation stamp share one 64 bit
+ * word per node. An entry whose stamp is not the current generation reads as
+ * a singleton, so reset() after a search expands all blossoms in O(1) without
+ * touching the nodes, like path1/path2 are invalidated by strue.
+ *
+ *****************************************************************************/
+
+#ifndef BLOSSOM_BASE_H
+#define BLOSSOM_BASE_H
+
+#include <stdint.h>
+#include <algorithm>
+#include <vector>
+
+#include "definitions.h"
+#include "dyn_graph_access.h"
+
+class blossom_base 
+{
+        public:
+                blossom_base() : m_generation(1) {}
+
+                blossom_base(dyn_graph_access * G) {
+                        init(G); 
+                }
+
+                inline void init( dyn_graph_access * G) {
+                        m_entry.assign(G->number_of_nodes(), 0);
+                        m_generation = 1;
+                }
+
+                // iterative with path halving
+                inline NodeID Find(NodeID element) {
+                        NodeID parent = get_parent(element);
+                        while( parent != element ) {
+                                NodeID grand_parent = get_parent(parent);
+                                if( grand_parent == parent ) return parent;
+                                set_parent(element, grand_parent);
+                                element = grand_parent;
+                                parent  = get_parent(element);
+                        }
+                        return element;
+                }
+
+                inline void union_blocks(NodeID lhs, NodeID rhs) {
+                        NodeID set_lhs = Find(lhs);
+                        NodeID set_rhs = Find(rhs);
+                        if( set_lhs == set_rhs ) return;
+
+                        uint32_t rank_lhs = get_rank(set_lhs);
+                        uint32_t rank_rhs = get_rank(set_rhs);
+                        if( rank_lhs < rank_rhs ) {
+                                set_parent(set_lhs, set_rhs);
+                        } else {
+                                set_parent(set_rhs, set_lhs);
+                                if( rank_lhs == rank_rhs ) set_entry(set_lhs, set_lhs, rank_lhs + 1);
+                        }
+                }
+
+                // makes v the representative of its set
+                inline void make_rep( NodeID v) {
+                        NodeID set = Find(v);
+                        if ( set != v ) {
+                                set_entry(v, v, get_rank(set));
+                                set_parent(set, v);
+                        }
+                }
+
+                // all nodes are singletons again
+                inline void reset() {
+                        if( ++m_generation == GENERATIONS ) {
+                                std::fill(m_entry.begin(), m_entry.end(), 0);
+                                m_generation = 1;
+                        }
+                }
+
+                NodeID operator()( NodeID v ) { return Find( v ); }
+
+        private:
+                // parent (32 bits) | generation (24 bits) | rank (8 bits), generation
+                // 0 is never current so zeroed entries are singletons
+                static const uint32_t GENERATIONS = 1 << 24;
+
+                inline bool current(uint64_t entry) const {
+                        return ((entry >> 8) & (GENERATIONS - 1)) == m_generation;
+                }
+
+                inline NodeID get_parent(NodeID v) const {
+                        uint64_t entry = m_entry[v];
+                        return current(entry) ? (NodeID) (entry >> 32) : v;
+                }
+
+                inline uint32_t get_rank(NodeID v) const {
+                        uint64_t entry = m_entry[v];
+                        return current(entry) ? (uint32_t) (entry & 0xff) : 0;
+                }
+
+                inline void set_entry(NodeID v, NodeID parent, uint32_t rank) {
+                        m_entry[v] = ((uint64_t) parent << 32) | ((uint64_t) m_generation << 8) | std::min(rank, 0xffu);
+                }
+
+                inline void set_parent(NodeID v, NodeID parent) {
+                        set_entry(v, parent, get_rank(v));
+                }
+
+                std::vector< uint64_t > m_entry;
+                uint32_t                m_generation;
+};
+
+#endif
@@ -0,0 +1,55 @@
+/******************************************************************************
+ * blossom_node.h
+ *
+ * Search state of one node in the blossom engines. Growing a tree reads the
+ * label, the predecessor and the path marks of a node together, so they are
+ * packed into one 8 byte record instead of four arrays. The mate stays in
+ * dyn_matching::matching.
+ *
+ *****************************************************************************/
+
+#ifndef BLOSSOM_NODE_H
+#define BLOSSOM_NODE_H
+
+#include <stdint.h>
+#include <vector>
+
+#include "definitions.h"
+
+struct blossom_node {
+        NodeID   pred;
+        uint32_t label   : 2;  // EVEN, ODD or UNLABELED
+        uint32_t visited : 1;
+        // a node is on path1 (path2) of the current walk towards the roots if
+        // it carries the current stamp and the bit is set
+        uint32_t path1   : 1;
+        uint32_t path2   : 1;
+        uint32_t stamp   : 27;
+
+        blossom_node() : pred(UNDEFINED_NODE), label(EVEN), visited(false), path1(false), path2(false), stamp(0) {}
+
+        inline bool on_path1( uint32_t s ) const { return stamp == s && path1; }
+        inline bool on_path2( uint32_t s ) const { return stamp == s && path2; }
+
+        inline void mark_path1( uint32_t s ) {
+                if( stamp != s ) { stamp = s; path2 = false; }
+                path1 = true;
+        }
+        inline void mark_path2( uint32_t s ) {
+                if( stamp != s ) { stamp = s; path1 = false; }
+                path2 = true;
+        }
+};
+
+// the next path stamp, all stamps are cleared when the counter wraps
+inline uint32_t next_path_stamp( std::vector< blossom_node > & nodes, uint32_t & stamp ) {
+        if( ++stamp == (1u << 27) ) {
+                for( size_t i = 0; i < nodes.size(); i++) {
+                        nodes[i].stamp = 0;
+                }
+                stamp = 1;
+        }
+        return stamp;
+}
+
+#endif
@@ -0,0 +1,146 @@
+/******************************************************************************
+ * concurrent_matching.h
+ *
+ * A published copy of a matching that any number of reader threads can query
+ * while a single writer keeps updating the live matching. The writer publishes
+ * at batch boundaries; readers always see the matching of one publish and
+ * never block the writer (seqlock).
+ *
+ *****************************************************************************/
+
+#ifndef CONCURRENT_MATCHING_H
+#define CONCURRENT_MATCHING_H
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "definitions.h"
+
+class concurrent_matching {
+        public:
+                concurrent_matching(NodeID n) : m_n(n), m_mates(new std::atomic<NodeID>[n]) {
+                        m_sequence.store(0);
+                        m_size.store(0);
+                        for( NodeID u = 0; u < n; u++) {
+                                m_mates[u].store(NOMATE, std::memory_order_relaxed);
+                        }
+                }
+
+                // writer side: make the given matching visible to readers. only
+                // entries that differ from the published ones are written while
+                // readers have to retry
+                void publish(const std::vector< NodeID > & matching, NodeID matching_size) {
+                        m_changed.clear();
+                        for( NodeID u = 0; u < m_n; u++) {
+                                if( m_mates[u].load(std::memory_order_relaxed) != matching[u] ) {
+                                        m_changed.push_back(u);
+                                }
+                        }
+
+                        uint64_t sequence = m_sequence.load(std::memory_order_relaxed);
+                        m_sequence.store(sequence + 1, std::memory_order_relaxed);
+                        std::atomic_thread_fence(std::memory_order_release);
+
+                        for( size_t i = 0; i < m_changed.size(); i++) {
+                                NodeID u = m_changed[i];
+                                m_mates[u].store(matching[u], std::memory_order_relaxed);
+                        }
+                        m_size.store(matching_size, std::memory_order_relaxed);
+
+                        m_sequence.store(sequence + 2, std::memory_order_release);
+                }
+
+                // same as above but only applies the changes since the last
+                // publish, see dyn_matching::drain_deltas
+                void publish(const std::vector< MatchingDelta > & deltas, NodeID matching_size) {
+                        uint64_t sequence = m_sequence.load(std::memory_order_relaxed);
+                        m_sequence.store(sequence + 1, std::memory_order_relaxed);
+                        std::atomic_thread_fence(std::memory_order_release);
+
+                        for( size_t i = 0; i < deltas.size(); i++) {
+                                const MatchingDelta & delta = deltas[i];
+                                m_mates[delta.u].store(delta.matched ? delta.v : NOMATE, std::memory_order_relaxed);
+                                m_mates[delta.v].store(delta.matched ? delta.u : NOMATE, std::memory_order_relaxed);
+                        }
+                        m_size.store(matching_size, std::memory_order_relaxed);
+
+                        m_sequence.store(sequence + 2, std::memory_order_release);
+                }
+
+                // reader side, safe to call from any thread
+                NodeID mate(NodeID u) const {
+                        NodeID result;
+                        uint64_t sequence;
+                        do {
+                                sequence = begin_read();
+                                result   = m_mates[u].load(std::memory_order_relaxed);
+                        } while( !end_read(sequence) );
+                        return result;
+                }
+
+                bool is_matched(NodeID u, NodeID v) const {
+                        bool result;
+                        uint64_t sequence;
+                        do {
+                                sequence = begin_read();
+                                result   = m_mates[u].load(std::memory_order_relaxed) == v
+                                        && m_mates[v].load(std::memory_order_relaxed) == u;
+                        } while( !end_read(sequence) );
+                        return result;
+                }
+
+                NodeID size() const {
+                        NodeID result;
+                        uint64_t sequence;
+                        do {
+                                sequence = begin_read();
+                                result   = m_size.load(std::memory_order_relaxed);
+                        } while( !end_read(sequence) );
+                        return result;
+                }
+
+                // answers a batch of queries from a single published matching
+                void mates(const NodeID * nodes, NodeID * result, size_t count) const {
+                        uint64_t sequence;
+                        do {
+                                sequence = begin_read();
+                                for( size_t i = 0; i < count; i++) {
+                                        result[i] = m_mates[nodes[i]].load(std::memory_order_relaxed);
+                                }
+                        } while( !end_read(sequence) );
+                }
+
+                // number of completed publishes
+                uint64_t epoch() const {
+                        return m_sequence.load(std::memory_order_acquire) / 2;
+                }
+
+                NodeID number_of_nodes() const {
+                        return m_n;
+                }
+
+        private:
+                uint64_t begin_read() const {
+                        uint64_t sequence = m_sequence.load(std::memory_order_acquire);
+                        while( sequence & 1 ) { // publish in progress
+                                sequence = m_sequence.load(std::memory_order_acquire);
+                        }
+                        return sequence;
+                }
+
+                bool end_read(uint64_t sequence) const {
+                        std::atomic_thread_fence(std::memory_order_acquire);
+                        return m_sequence.load(std::memory_order_relaxed) == sequence;
+                }
+
+                NodeID m_n;
+                std::unique_ptr< std::atomic<NodeID>[] > m_mates;
+                std::atomic< NodeID > m_size;
+                std::atomic< uint64_t > m_sequence;
+
+                // writer only
+                std::vector< NodeID > m_changed;
+};
+
+#endif // CONCURRENT_MATCHING_H
@@ -0,0 +1,55 @@
+/******************************************************************************
+ * deferred_searches.h
+ *
+ * Free nodes whose augmenting path search was skipped by the lazy mode of
+ * the dynblossom engines, keyed by the bucket of their degree when they were
+ * queued (as in free_vertex_index), so high degree nodes, which most likely
+ * still have an augmenting path, are searched first. Keying by the degree
+ * itself would let every deleteMax that empties the queue walk O(n) buckets.
+ *
+ *****************************************************************************/
+
+#ifndef DEFERRED_SEARCHES_H
+#define DEFERRED_SEARCHES_H
+
+#include "definitions.h"
+#include "free_vertex_index.h"
+#include "io/checkpoint_io.h"
+#include "priority_queues/node_bucket_pq.h"
+
+class deferred_searches
+{
+        public:
+                // n is 0 if the engine is not lazy
+                deferred_searches( NodeID n ) : m_queue(n, 64) {}
+
+                inline void defer( NodeID v, EdgeID degree ) {
+                        Gain key = free_vertex_index::bucket_of(degree);
+                        if( m_queue.contains(v) ) {
+                                m_queue.changeKey(v, key);
+                        } else {
+                                m_queue.insert(v, key);
+                        }
+                }
+
+                // calls search(v) for the queued nodes by decreasing degree until
+                // searches of them returned true. search returns false for a node
+                // that got matched in the meantime
+                template< typename search_type >
+                void repair( size_t searches, search_type search ) {
+                        while( searches > 0 && !m_queue.empty() ) {
+                                if( search(m_queue.deleteMax()) ) searches--;
+                        }
+                }
+
+                inline NodeID size()  { return m_queue.size(); }
+                inline void   clear() { while( !m_queue.empty() ) m_queue.deleteMax(); }
+
+                void checkpoint( checkpoint_writer & writer ) { m_queue.checkpoint(writer); }
+                void restore( checkpoint_reader & reader )    { m_queue.restore(reader); }
+
+        private:
+                node_bucket_pq m_queue;
+};
+
+#endif
@@ -5,6 +5,7 @@
  *****************************************************************************/
 
 #include "dyn_graph_access.h"
+#include "io/checkpoint_io.h"
 
 dyn_graph_access::dyn_graph_access() : m_building_graph(false) {
         edge_count = 0;
@@ -43,6 +44,28 @@ void dyn_graph_access::finish_construction() {
         m_edges_maps.resize(node_count);
 }
 
+void dyn_graph_access::bulk_load(const std::vector<std::pair<int, std::pair<NodeID, NodeID> > > & sequence, size_t begin, size_t end) {
+        // upper bounds, duplicate insertions are filtered by new_edge
+        std::vector< EdgeID > degrees(node_count, 0);
+        for( size_t i = begin; i < end; i++) {
+                ASSERT_TRUE(sequence[i].first);
+                degrees[sequence[i].second.first]++;
+                degrees[sequence[i].second.second]++;
+        }
+
+        for( NodeID node = 0; node < node_count; node++) {
+                if( degrees[node] == 0 ) continue;
+                m_edges[node].reserve(m_edges[node].size() + degrees[node]);
+                m_edges_maps[node].resize(m_edges_maps[node].size() + degrees[node]);
+        }
+
+        for( size_t i = begin; i < end; i++) {
+                const std::pair<NodeID, NodeID> & edge = sequence[i].second;
+                new_edge(edge.first, edge.second);
+                new_edge(edge.second, edge.first);
+        }
+}
+
 void dyn_graph_access::convert_from_graph_access(graph_access& H) {
         dyn_graph_access(H.number_of_nodes());
 
@@ -73,5 +96,49 @@ void dyn_graph_access::convert_to_graph_access(graph_access& H) {
         ASSERT_TRUE(number_of_edges() == H.number_of_edges());
 }
 
+void dyn_graph_access::checkpoint(checkpoint_writer & writer) {
+        std::vector< EdgeID > degrees(node_count);
+        uint64_t total = 0;
+        for( NodeID node = 0; node < node_count; node++) {
+                degrees[node] = m_edges[node].size();
+                total += degrees[node];
+        }
 
+        writer.write(node_count);
+        writer.write(edge_count);
+        writer.write_vector(degrees);
+        writer.write(total);
+        for( NodeID node = 0; node < node_count; node++) {
+                writer.write_bytes(m_edges[node].data(), m_edges[node].size() * sizeof(DynEdge));
+        }
+}
 
+bool dyn_graph_access::restore(checkpoint_reader & reader) {
+        NodeID n = 0;
+        EdgeID m = 0;
+        reader.read(n);
+        reader.read(m);
+        if( n != node_count ) return false;
+
+        uint64_t degree_count = 0, total = 0;
+        const EdgeID  * degrees = reader.read_array< EdgeID >(degree_count);
+        const DynEdge * targets = reader.read_array< DynEdge >(total);
+        if( !reader.ok() || degree_count != n ) return false;
+
+        uint64_t offset = 0;
+        for( NodeID node = 0; node < n; node++) {
+                if( degrees[node] > total - offset ) return false;
+
+                m_edges[node].assign(targets + offset, targets + offset + degrees[node]);
+                m_edges_maps[node].clear();
+                m_edges_maps[node].resize(degrees[node]);
+                for( EdgeID e = 0; e < degrees[node]; e++) {
+                        if( targets[offset + e].target >= n ) return false;
+                        m_edges_maps[node][targets[offset + e].target] = e;
+                }
+                offset += degrees[node];
+        }
+        edge_count = m;
+
+        return offset == total;
+}
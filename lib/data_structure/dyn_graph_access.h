@@ -15,6 +15,8 @@
 #include "../definitions.h"
 #include "graph_access.h"
 
+class checkpoint_writer;
+class checkpoint_reader;
 
 class dyn_graph_access {
         public:
@@ -35,6 +37,12 @@ class dyn_graph_access {
 
                 inline bool isEdge(NodeID source, NodeID target);
 
+                // inserts the edges of sequence[begin, end), which must all be
+                // insertions, in both directions. same result as calling new_edge
+                // for each of them but the adjacency arrays and the edge index are
+                // sized once up front
+                void bulk_load(const std::vector<std::pair<int, std::pair<NodeID, NodeID> > > & sequence, size_t begin, size_t end);
+
                 // access
                 inline EdgeID number_of_edges();
                 inline NodeID number_of_nodes();
@@ -47,6 +55,21 @@ class dyn_graph_access {
                 inline EdgeID getNodeDegree(NodeID node);
                 inline NodeID getEdgeTarget(NodeID source, EdgeID edge);
 
+                // the getNodeDegree(node) edges of node, for vectorized scans. valid
+                // until the next update of node
+                inline const DynEdge * get_edges(NodeID node);
+
+                // hints for code that interleaves several walks: the degree of node,
+                // resp. the target of the given edge, is needed soon
+                inline void prefetch_node(NodeID node);
+                inline void prefetch_edge(NodeID source, EdgeID edge);
+
+                // binary checkpoints, see io/checkpoint_io.h. the adjacency arrays
+                // keep their order, restore rebuilds the edge index. restore fails
+                // if the checkpoint has a different number of nodes
+                void checkpoint(checkpoint_writer & writer);
+                bool restore(checkpoint_reader & reader);
+
         private:
                 // %%%%%%%%%%%%%%%%%%% DATA %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
                 std::vector<std::vector<DynEdge> > m_edges;
@@ -135,4 +158,16 @@ NodeID dyn_graph_access::getEdgeTarget(NodeID source, EdgeID edge) {
         return m_edges[source][edge].target;
 }
 
+const DynEdge * dyn_graph_access::get_edges(NodeID node) {
+        return m_edges[node].data();
+}
+
+void dyn_graph_access::prefetch_node(NodeID node) {
+        PREFETCH(&m_edges[node]);
+}
+
+void dyn_graph_access::prefetch_edge(NodeID source, EdgeID edge) {
+        PREFETCH(m_edges[source].data() + edge);
+}
+
 #endif /* end of include guard: dyn_graph_access_EFRXO4X2 */
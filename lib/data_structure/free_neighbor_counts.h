@@ -0,0 +1,126 @@
+/******************************************************************************
+ * free_neighbor_counts.h
+ *
+ * Number of free neighbors of the high degree nodes, so that a scan of such
+ * a node for a free neighbor, which usually finds none, is skipped when the
+ * count is zero. Low degree nodes are cheap to scan and not counted. Every
+ * node keeps a list of its high degree neighbors, so a node whose status
+ * changes pays for its high degree neighbors only. A node is counted from
+ * degree 2*LOW on and until its degree drops below LOW, then the cost of
+ * starting and stopping to count it is amortized over the edge updates.
+ *
+ *****************************************************************************/
+
+#ifndef FREE_NEIGHBOR_COUNTS_H
+#define FREE_NEIGHBOR_COUNTS_H
+
+#include <vector>
+
+#include "definitions.h"
+#include "dyn_graph_access.h"
+
+class free_neighbor_counts
+{
+        public:
+                free_neighbor_counts() : G(NULL), m_matching(NULL) {}
+
+                // counts from scratch
+                void init( dyn_graph_access * G, const std::vector< NodeID > & matching ) {
+                        this->G    = G;
+                        m_matching = &matching;
+                        m_count.assign(G->number_of_nodes(), NOT_COUNTED);
+                        m_heavy_neighbors.assign(G->number_of_nodes(), std::vector< NodeID >());
+                        forall_nodes((*G), v) {
+                                if( G->getNodeDegree(v) >= 2*LOW ) start_counting(v);
+                        } endfor
+                }
+
+                // false only if u has no free neighbor
+                inline bool any( NodeID u ) const {
+                        return m_count[u] != 0;
+                }
+
+                inline void became_free( NodeID v ) {
+                        const std::vector< NodeID > & heavy = m_heavy_neighbors[v];
+                        for( size_t i = 0; i < heavy.size(); i++) m_count[heavy[i]]++;
+                }
+
+                inline void became_matched( NodeID v ) {
+                        const std::vector< NodeID > & heavy = m_heavy_neighbors[v];
+                        for( size_t i = 0; i < heavy.size(); i++) m_count[heavy[i]]--;
+                }
+
+                // after the edge was added to G. not for a duplicate, u would be
+                // listed twice at v
+                inline void edge_added( NodeID u, NodeID v, bool u_free, bool v_free ) {
+                        add_side(u, v, v_free);
+                        add_side(v, u, u_free);
+                }
+
+                // after the edge was removed from G, not if it was missing
+                inline void edge_removed( NodeID u, NodeID v, bool u_free, bool v_free ) {
+                        remove_side(u, v, v_free);
+                        remove_side(v, u, u_free);
+                }
+
+        private:
+                static const NodeID LOW         = 32;
+                static const NodeID NOT_COUNTED = std::numeric_limits< NodeID >::max();
+
+                inline bool counted( NodeID u ) const {
+                        return m_count[u] != NOT_COUNTED;
+                }
+
+                // the edge to v was added to u
+                inline void add_side( NodeID u, NodeID v, bool v_free ) {
+                        if( counted(u) ) {
+                                m_heavy_neighbors[v].push_back(u);
+                                if( v_free ) m_count[u]++;
+                        } else if( G->getNodeDegree(u) >= 2*LOW ) {
+                                start_counting(u);
+                        }
+                }
+
+                // the edge to v was removed from u
+                inline void remove_side( NodeID u, NodeID v, bool v_free ) {
+                        if( !counted(u) ) return;
+
+                        erase(m_heavy_neighbors[v], u);
+                        if( v_free ) m_count[u]--;
+                        if( G->getNodeDegree(u) < LOW ) stop_counting(u);
+                }
+
+                void start_counting( NodeID u ) {
+                        NodeID count = 0;
+                        forall_out_edges((*G), e, u) {
+                                NodeID w = G->getEdgeTarget(u, e);
+                                m_heavy_neighbors[w].push_back(u);
+                                if( (*m_matching)[w] == NOMATE ) count++;
+                        } endfor
+                        m_count[u] = count;
+                }
+
+                void stop_counting( NodeID u ) {
+                        forall_out_edges((*G), e, u) {
+                                erase(m_heavy_neighbors[G->getEdgeTarget(u, e)], u);
+                        } endfor
+                        m_count[u] = NOT_COUNTED;
+                }
+
+                static inline void erase( std::vector< NodeID > & list, NodeID u ) {
+                        for( size_t i = 0; i < list.size(); i++) {
+                                if( list[i] == u ) {
+                                        list[i] = list.back();
+                                        list.pop_back();
+                                        return;
+                                }
+                        }
+                }
+
+                dyn_graph_access *                   G;
+                const std::vector< NodeID > *        m_matching;
+                std::vector< NodeID >                m_count; // NOT_COUNTED for low degree nodes
+                std::vector< std::vector< NodeID > > m_heavy_neighbors;
+};
+
+#endif
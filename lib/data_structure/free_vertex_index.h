@@ -0,0 +1,135 @@
+/******************************************************************************
+ * free_vertex_index.h
+ *
+ * The free nodes of the matching in dense arrays with a position map, so
+ * membership, insertion, removal and uniform sampling are O(1) and the free
+ * nodes can be visited without a scan over all nodes. By degree the nodes are
+ * kept in buckets of equal floor(log2(degree)+1), bucket 0 holds the isolated
+ * ones. Otherwise all nodes are in bucket 0.
+ *
+ *****************************************************************************/
+
+#ifndef FREE_VERTEX_INDEX_H
+#define FREE_VERTEX_INDEX_H
+
+#include <stdint.h>
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+#include "definitions.h"
+#include "dyn_graph_access.h"
+#include "tools/random_functions.h"
+
+class free_vertex_index
+{
+        public:
+                free_vertex_index() : G(NULL), m_by_degree(false), m_size(0) {}
+
+                // indexes from scratch
+                void init( dyn_graph_access * G, const std::vector< NodeID > & matching, bool by_degree ) {
+                        this->G     = G;
+                        m_by_degree = by_degree;
+                        m_size      = 0;
+                        m_buckets.assign(by_degree ? BUCKETS : 1, std::vector< NodeID >());
+                        m_position.assign(G->number_of_nodes(), NOT_FREE);
+                        m_bucket.assign(by_degree ? G->number_of_nodes() : 0, 0);
+                        forall_nodes((*G), v) {
+                                if( matching[v] == NOMATE ) insert(v);
+                        } endfor
+                }
+
+                inline bool contains( NodeID v ) const {
+                        return m_position[v] != NOT_FREE;
+                }
+
+                inline NodeID size() const {
+                        return m_size;
+                }
+
+                // free nodes with at least one edge, only kept by degree
+                inline NodeID size_with_edges() const {
+                        return m_size - m_buckets[0].size();
+                }
+
+                inline unsigned buckets() const {
+                        return m_buckets.size();
+                }
+
+                // the free nodes of bucket b in no particular order
+                inline const std::vector< NodeID > & bucket( unsigned b ) const {
+                        return m_buckets[b];
+                }
+
+                static inline unsigned bucket_of( EdgeID degree ) {
+                        return degree == 0 ? 0 : 64 - __builtin_clzll((unsigned long long) degree);
+                }
+
+                inline void insert( NodeID v ) {
+                        unsigned b = m_by_degree ? bucket_of(G->getNodeDegree(v)) : 0;
+                        if( m_by_degree ) m_bucket[v] = b;
+                        m_position[v] = m_buckets[b].size();
+                        m_buckets[b].push_back(v);
+                        m_size++;
+                }
+
+                inline void erase( NodeID v ) {
+                        std::vector< NodeID > & nodes = m_buckets[m_by_degree ? m_bucket[v] : 0];
+                        NodeID last = nodes.back();
+                        nodes[m_position[v]] = last;
+                        m_position[last]     = m_position[v];
+                        m_position[v]        = NOT_FREE;
+                        nodes.pop_back();
+                        m_size--;
+                }
+
+                // after an edge of v was added or removed. the bucket can only change
+                // if the new or the old degree is a power of two or zero, so mostly
+                // the index is not touched
+                inline void degree_changed( NodeID v ) {
+                        if( !m_by_degree ) return;
+                        EdgeID degree = G->getNodeDegree(v);
+                        if( (degree & (degree - 1)) != 0 && (degree & (degree + 1)) != 0 ) return;
+                        if( !contains(v) || m_bucket[v] == bucket_of(degree) ) return;
+                        erase(v);
+                        insert(v);
+                }
+
+                // uniform among the free nodes in buckets from..buckets()-1, which
+                // must not all be empty
+                NodeID sample( unsigned from = 0 ) const {
+                        NodeID count = 0;
+                        for( unsigned b = from; b < m_buckets.size(); b++) count += m_buckets[b].size();
+
+                        NodeID r = random_functions::nextInt(0, count - 1);
+                        for( unsigned b = from; ; b++) {
+                                if( r < m_buckets[b].size() ) return m_buckets[b][r];
+                                r -= m_buckets[b].size();
+                        }
+                }
+
+                // the free nodes, or only those with edges, in increasing order,
+                // i.e. in the order of forall_nodes
+                void sorted( std::vector< NodeID > & nodes, bool with_edges = false ) const {
+                        nodes.clear();
+                        for( unsigned b = with_edges && m_by_degree ? 1 : 0; b < m_buckets.size(); b++) {
+                                for( NodeID v : m_buckets[b] ) {
+                                        if( !with_edges || G->getNodeDegree(v) > 0 ) nodes.push_back(v);
+                                }
+                        }
+                        std::sort(nodes.begin(), nodes.end());
+                }
+
+        private:
+                static const unsigned BUCKETS  = 65;
+                static const NodeID   NOT_FREE = std::numeric_limits< NodeID >::max();
+
+                dyn_graph_access *                   G;
+                bool                                 m_by_degree;
+                NodeID                               m_size;
+                std::vector< std::vector< NodeID > > m_buckets;
+                std::vector< NodeID >                m_position; // in its bucket, NOT_FREE if matched
+                std::vector< uint8_t >               m_bucket;   // by degree only
+};
+
+#endif
@@ -10,6 +10,7 @@
 #include <unordered_map>
 
 #include "definitions.h"
+#include "io/checkpoint_io.h"
 #include "priority_queue_interface.h"
 
 class node_bucket_pq : public priority_queue_interface
@@ -37,6 +38,10 @@ public:
     bool contains(NodeID node);
     EdgeWeight gain(NodeID Node);
 
+    // binary checkpoints, only the non-empty buckets are written
+    void checkpoint(checkpoint_writer & writer);
+    void restore(checkpoint_reader & reader);
+
 private:
     NodeID m_elements;
     EdgeWeight m_gain_span;
@@ -167,4 +172,42 @@ inline Gain node_bucket_pq::gain(NodeID node) {
     }
 }
 
+inline void node_bucket_pq::checkpoint(checkpoint_writer & writer) {
+    writer.write(m_elements);
+    writer.write(m_gain_span);
+    writer.write(m_max_idx);
+    writer.write_vector(m_queue_index);
+
+    uint64_t non_empty = 0;
+    for (unsigned i = 0; i < m_buckets.size(); i++) {
+        if (!m_buckets[i].empty()) non_empty++;
+    }
+    writer.write(non_empty);
+    for (uint64_t i = 0; i < m_buckets.size(); i++) {
+        if (m_buckets[i].empty()) continue;
+        writer.write(i);
+        writer.write_vector(m_buckets[i]);
+    }
+}
+
+inline void node_bucket_pq::restore(checkpoint_reader & reader) {
+    reader.read(m_elements);
+    reader.read(m_gain_span);
+    reader.read(m_max_idx);
+    reader.read_vector(m_queue_index);
+
+    m_buckets.clear();
+    m_buckets.resize(2 * m_gain_span + 1);
+
+    uint64_t non_empty = 0;
+    reader.read(non_empty);
+    std::vector<NodeID> bucket;
+    for (uint64_t j = 0; j < non_empty && reader.ok(); j++) {
+        uint64_t i = 0;
+        reader.read(i);
+        reader.read_vector(bucket);
+        if (i < m_buckets.size()) m_buckets[i].swap(bucket);
+    }
+}
+
 #endif
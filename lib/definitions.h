@@ -23,6 +23,13 @@
         #define PRINT(x) do {} while (false);
 #endif
 
+// read prefetch of the cache line of address x, no-op on other compilers
+#if defined(__GNUC__)
+        #define PREFETCH(x) __builtin_prefetch((x), 0, 3)
+#else
+        #define PREFETCH(x) do {} while (false)
+#endif
+
 /**********************************************
  * Constants
  * ********************************************/
@@ -80,6 +87,13 @@ struct Edge {
 
 typedef std::vector<NodeID> Matching;
 
+// one change of a matching: {u,v} became matched (matched = 1) or unmatched (matched = 0)
+struct MatchingDelta {
+    NodeID u;
+    NodeID v;
+    NodeID matched;
+};
+
 //AlgorithmType
 typedef enum {
         RANDOM_WALK, 
@@ -88,21 +102,43 @@ typedef enum {
         NAIVE,
  	DYNBLOSSOM, 
  	DYNBLOSSOMNAIVE, 
-        BLOSSOM	
+        BLOSSOM,
+        DYNBIPARTITE,
+        HOPCROFTKARP
 } AlgorithmType;
 
 typedef enum {
         BLOSSOMEMPTY,
         BLOSSOMGREEDY,
-        BLOSSOMEXTRAGREEDY
+        BLOSSOMEXTRAGREEDY,
+        BLOSSOMKARPSIPSER
 } BlossomInitType;
 
+typedef enum {
+        STATIC_EDMONDS,
+        STATIC_PHASES,
+        STATIC_PARALLEL
+} StaticEngineType;
+
 typedef enum {
         PERMUTATION_QUALITY_NONE, 
 	PERMUTATION_QUALITY_FAST,  
 	PERMUTATION_QUALITY_GOOD
 } PermutationQuality;
 
+typedef enum {
+        RNG_XOSHIRO256SS,
+        RNG_PCG32,
+        RNG_SPLITMIX64,
+        RNG_MT19937,
+        RNG_PHILOX4X32
+} RandomEngineType;
+
+// engine of random_functions unless --rng says otherwise, set by cmake -DRNG_ENGINE
+#ifndef DEFAULT_RNG_ENGINE
+#define DEFAULT_RNG_ENGINE RNG_XOSHIRO256SS
+#endif
+
 
 #endif
 
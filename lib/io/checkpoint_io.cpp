@@ -0,0 +1,127 @@
+/******************************************************************************
+ * checkpoint_io.cpp
+ *
+ *****************************************************************************/
+
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <iostream>
+
+#include "checkpoint_io.h"
+#include "data_structure/dyn_graph_access.h"
+#include "dyn_matching.h"
+#include "tools/random_functions.h"
+
+static const char     CHECKPOINT_MAGIC[8] = {'D','Y','N','M','A','T','C','H'};
+static const uint32_t CHECKPOINT_VERSION  = 4;
+
+struct checkpoint_header {
+        char     magic[8];
+        uint32_t version;
+        uint32_t algorithm;
+        uint64_t position;
+};
+
+int checkpoint_io::write(const std::string & filename, dyn_graph_access * G, dyn_matching * algorithm,
+                         AlgorithmType algorithm_type, uint64_t position) {
+        std::string tmp_filename = filename + ".tmp";
+        FILE * out = fopen(tmp_filename.c_str(), "wb");
+        if( out == NULL ) {
+                std::cerr << "Error opening " << tmp_filename << std::endl;
+                return 1;
+        }
+
+        checkpoint_header header;
+        memcpy(header.magic, CHECKPOINT_MAGIC, sizeof(header.magic));
+        header.version   = CHECKPOINT_VERSION;
+        header.algorithm = algorithm_type;
+        header.position  = position;
+
+        checkpoint_writer writer(out);
+        writer.write(header);
+        G->checkpoint(writer);
+        writer.write_string(random_functions::get_stream().state());
+        algorithm->checkpoint(writer);
+
+        bool ok = writer.ok() && fflush(out) == 0 && fsync(fileno(out)) == 0;
+        ok = fclose(out) == 0 && ok;
+        if( !ok || rename(tmp_filename.c_str(), filename.c_str()) != 0 ) {
+                std::cerr << "Error writing checkpoint " << filename << std::endl;
+                unlink(tmp_filename.c_str());
+                return 1;
+        }
+
+        return 0;
+}
+
+pid_t checkpoint_io::write_async(const std::string & filename, dyn_graph_access * G, dyn_matching * algorithm,
+                                 AlgorithmType algorithm_type, uint64_t position) {
+        pid_t child = fork();
+        if( child == 0 ) {
+                // _exit so that the child does not flush the buffers of the parent
+                _exit(write(filename, G, algorithm, algorithm_type, position));
+        }
+        return child;
+}
+
+int checkpoint_io::wait(pid_t child) {
+        int status = 0;
+        while( waitpid(child, &status, 0) < 0 ) {
+                if( errno != EINTR ) return 1;
+        }
+        return WIFEXITED(status) && WEXITSTATUS(status) == 0 ? 0 : 1;
+}
+
+int checkpoint_io::read(const std::string & filename, dyn_graph_access * G, dyn_matching * algorithm,
+                        AlgorithmType algorithm_type, uint64_t & position) {
+        int fd = open(filename.c_str(), O_RDONLY);
+        struct stat info;
+        if( fd < 0 || fstat(fd, &info) != 0 ) {
+                std::cerr << "Error opening " << filename << std::endl;
+                if( fd >= 0 ) close(fd);
+                return 1;
+        }
+
+        size_t size = info.st_size;
+        void * data = size > 0 ? mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0) : MAP_FAILED;
+        close(fd);
+        if( data == MAP_FAILED ) {
+                std::cerr << "Error mapping " << filename << std::endl;
+                return 1;
+        }
+        madvise(data, size, MADV_SEQUENTIAL);
+
+        checkpoint_reader reader((const char *) data, size);
+        checkpoint_header header;
+        reader.read(header);
+
+        int ret_code = 0;
+        if( memcmp(header.magic, CHECKPOINT_MAGIC, sizeof(header.magic)) != 0 || header.version != CHECKPOINT_VERSION ) {
+                std::cerr << filename << " is not a checkpoint of this version" << std::endl;
+                ret_code = 1;
+        } else if( header.algorithm != (uint32_t) algorithm_type ) {
+                std::cerr << filename << " was written by a different algorithm" << std::endl;
+                ret_code = 1;
+        } else if( !G->restore(reader) ) {
+                std::cerr << filename << " does not hold a graph with the same number of nodes" << std::endl;
+                ret_code = 1;
+        } else {
+                std::string rng_state;
+                reader.read_string(rng_state);
+                random_functions::get_stream().set_state(rng_state);
+                algorithm->restore(reader);
+                position = header.position;
+
+                if( !reader.ok() ) {
+                        std::cerr << filename << " is truncated" << std::endl;
+                        ret_code = 1;
+                }
+        }
+
+        munmap(data, size);
+        return ret_code;
+}
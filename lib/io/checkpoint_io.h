@@ -0,0 +1,144 @@
+/******************************************************************************
+ * checkpoint_io.h
+ *
+ * Binary checkpoints of a dynamic graph together with the state of the
+ * matching algorithm and the random stream, so that a replay can continue
+ * from the checkpoint instead of from the first update. Arrays are stored as
+ * a length followed by the raw words in host byte order, which lets a
+ * restore copy them straight out of the mapped file.
+ *
+ *****************************************************************************/
+
+#ifndef CHECKPOINT_IO_H
+#define CHECKPOINT_IO_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/types.h>
+#include <string>
+#include <vector>
+
+#include "definitions.h"
+
+class dyn_graph_access;
+class dyn_matching;
+
+class checkpoint_writer {
+        public:
+                checkpoint_writer(FILE * out) : m_out(out), m_ok(true) {}
+
+                template<typename T> void write(const T & value) {
+                        write_bytes(&value, sizeof(T));
+                }
+
+                template<typename T> void write_vector(const std::vector< T > & vec) {
+                        write_array(vec.data(), vec.size());
+                }
+
+                template<typename T> void write_array(const T * data, uint64_t count) {
+                        write(count);
+                        write_bytes(data, count * sizeof(T));
+                }
+
+                void write_string(const std::string & str) {
+                        write_array(str.data(), str.size());
+                }
+
+                void write_bytes(const void * data, size_t bytes) {
+                        if( bytes > 0 && fwrite(data, 1, bytes, m_out) != bytes ) m_ok = false;
+                }
+
+                bool ok() const { return m_ok; }
+
+        private:
+                FILE * m_out;
+                bool   m_ok;
+};
+
+// reads from a checkpoint in memory, usually a mapped file. reading past the
+// end yields zeros and clears ok(), so a truncated file is detected at the end
+class checkpoint_reader {
+        public:
+                checkpoint_reader(const char * data, size_t size) : m_pos(data), m_end(data + size), m_ok(true) {}
+
+                template<typename T> void read(T & value) {
+                        read_bytes(&value, sizeof(T));
+                }
+
+                template<typename T> void read_vector(std::vector< T > & vec) {
+                        uint64_t count = read_count(sizeof(T));
+                        vec.resize(count);
+                        read_bytes(vec.data(), count * sizeof(T));
+                }
+
+                // points into the checkpoint instead of copying, valid as long as the data is
+                template<typename T> const T * read_array(uint64_t & count) {
+                        count = read_count(sizeof(T));
+                        const T * data = (const T *) m_pos;
+                        m_pos += count * sizeof(T);
+                        return data;
+                }
+
+                void read_string(std::string & str) {
+                        uint64_t count = read_count(1);
+                        str.assign(m_pos, count);
+                        m_pos += count;
+                }
+
+                void read_bytes(void * data, size_t bytes) {
+                        if( bytes > (size_t) (m_end - m_pos) ) {
+                                m_ok = false;
+                                memset(data, 0, bytes);
+                                m_pos = m_end;
+                                return;
+                        }
+                        if( bytes > 0 ) memcpy(data, m_pos, bytes);
+                        m_pos += bytes;
+                }
+
+                bool ok() const { return m_ok; }
+
+        private:
+                uint64_t read_count(size_t element_size) {
+                        uint64_t count = 0;
+                        read(count);
+                        if( count > (uint64_t) (m_end - m_pos) / element_size ) {
+                                m_ok  = false;
+                                count = 0;
+                        }
+                        return count;
+                }
+
+                const char * m_pos;
+                const char * m_end;
+                bool         m_ok;
+};
+
+class checkpoint_io {
+        public:
+                // writes G, the state of the algorithm and the active random stream.
+                // position is the number of updates of the sequence processed so
+                // far. the file is written next to filename and renamed when
+                // complete, so an older checkpoint stays intact until then.
+                // returns 0 on success
+                static int write(const std::string & filename, dyn_graph_access * G, dyn_matching * algorithm,
+                                 AlgorithmType algorithm_type, uint64_t position);
+
+                // same as write but done by a forked child that works on a copy-on-write
+                // image of the process, so the caller can go on with updates right
+                // away. returns the pid of the child or -1 if fork failed
+                static pid_t write_async(const std::string & filename, dyn_graph_access * G, dyn_matching * algorithm,
+                                         AlgorithmType algorithm_type, uint64_t position);
+
+                // waits for a child started by write_async, returns 0 if it succeeded
+                static int wait(pid_t child);
+
+                // restores G, the algorithm and the active random stream. G and the
+                // algorithm have to be constructed like the ones that were written,
+                // i.e. same number of nodes and same algorithm. returns 0 on success
+                static int read(const std::string & filename, dyn_graph_access * G, dyn_matching * algorithm,
+                                AlgorithmType algorithm_type, uint64_t & position);
+};
+
+#endif // CHECKPOINT_IO_H
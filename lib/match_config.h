@@ -19,7 +19,19 @@ struct MatchConfig
 
         BlossomInitType blossom_init;
 
+        // exact solver of staticblossom and of post_blossom
+        StaticEngineType static_engine;
+
+        // threads of the parallel static engine and of the batch repair of randomwalk
+        int threads;
+
+        // runs of up to this many deletions are handed to remove_edges at once
+        int batch_size;
+
         int seed;
+
+        // engine behind random_functions
+        RandomEngineType rng_engine;
         
         std::string filename;
 
@@ -35,6 +47,21 @@ struct MatchConfig
 
         bool maintain_opt;
 
+        // keep the trees of exhausted failed searches until an update invalidates them
+        bool dynblossom_reuse_forest;
+
+        // searches for deferred free nodes per update skipped by --dynblossom_lazy,
+        // each scans at most dynblossom_repair_edges edges
+        unsigned dynblossom_repair_budget;
+        unsigned dynblossom_repair_edges;
+
+        // search from all deferred free nodes after the last update
+        bool dynblossom_lazy_drain;
+
+        // edges the local search through a new edge between two matched nodes may
+        // scan before it falls back to the global search, 0 disables it
+        unsigned long long dynblossom_local_budget;
+
         double bgs_factor;
 
         //***************************
@@ -45,9 +72,38 @@ struct MatchConfig
         unsigned int            rw_low_degree_value;
         bool                    rw_ending_additional_settle;
         unsigned long long      rw_repetitions_per_node;
+        // walks advanced together in the repair of a deletion batch, 0 repairs
+        // with the walks of single deletions
+        int                     rw_walk_group;
 
         bool naive_settle_on_insertion;
 
+        // naive, randomwalk and baswanaguptasen count the free neighbors of
+        // every node to skip scans for a free neighbor that find none
+        bool free_neighbor_counts;
+
+        //***************************
+        // Warm start
+        //***************************
+        bool                    bulk_load;
+        // number of updates to bulk load, 0 means the whole insert-only prefix
+        unsigned long long      bulk_load_prefix;
+
+        //***************************
+        // Bipartite graphs
+        //***************************
+        bool                    bipartite_detection;
+        std::string             sides_filename;
+        // side of every node if the graph is bipartite, empty otherwise
+        std::vector< NodeID >   sides;
+
+        //***************************
+        // Checkpoints
+        //***************************
+        std::string             checkpoint_filename;
+        unsigned long long      checkpoint_every;
+        std::string             restore_filename;
+
         void LogDump(FILE *out) const {
         }
 };
@@ -0,0 +1,81 @@
+/******************************************************************************
+ * bipartition.cpp
+ *
+ *****************************************************************************/
+
+#include <fstream>
+#include <iostream>
+
+#include "bipartition.h"
+
+bool bipartition::detect(NodeID n, const std::vector<std::pair<int, std::pair<NodeID, NodeID> > > & edge_sequence, std::vector< NodeID > & side) {
+        // adjacency of the union graph in CSR form, an edge may appear several times
+        std::vector< EdgeID > first(n + 1, 0);
+        for( auto & update : edge_sequence ) {
+                if( !update.first ) continue;
+                first[update.second.first + 1]++;
+                first[update.second.second + 1]++;
+        }
+        for( NodeID v = 0; v < n; v++) first[v+1] += first[v];
+
+        std::vector< NodeID > adjacent(first[n]);
+        std::vector< EdgeID > pos(first.begin(), first.end() - 1);
+        for( auto & update : edge_sequence ) {
+                if( !update.first ) continue;
+                NodeID u = update.second.first, v = update.second.second;
+                if( u == v ) {
+                        side.clear();
+                        return false;
+                }
+                adjacent[pos[u]++] = v;
+                adjacent[pos[v]++] = u;
+        }
+
+        side.assign(n, UNDEFINED_NODE);
+        std::vector< NodeID > queue;
+        for( NodeID s = 0; s < n; s++) {
+                if( side[s] != UNDEFINED_NODE ) continue;
+
+                side[s] = 0;
+                queue.clear(); queue.push_back(s);
+                for( size_t head = 0; head < queue.size(); head++) {
+                        NodeID u = queue[head];
+                        for( EdgeID e = first[u]; e < first[u+1]; e++) {
+                                NodeID v = adjacent[e];
+                                if( side[v] == UNDEFINED_NODE ) {
+                                        side[v] = 1 - side[u];
+                                        queue.push_back(v);
+                                } else if( side[v] == side[u] ) {
+                                        side.clear();
+                                        return false;
+                                }
+                        }
+                }
+        }
+        return true;
+}
+
+bool bipartition::read(const std::string & filename, NodeID n, const std::vector<std::pair<int, std::pair<NodeID, NodeID> > > & edge_sequence, std::vector< NodeID > & side) {
+        std::ifstream in(filename.c_str());
+        if (!in) {
+                std::cerr << "Error opening " << filename << std::endl;
+                return false;
+        }
+
+        // nodes missing from the file are on side 0
+        side.assign(n, 0);
+        NodeID value = 0;
+        for( NodeID v = 0; v < n && in >> value; v++) {
+                side[v] = value ? 1 : 0;
+        }
+
+        for( auto & update : edge_sequence ) {
+                if( update.first && side[update.second.first] == side[update.second.second] ) {
+                        std::cerr << filename << ": edge " << update.second.first << " " << update.second.second 
+                                  << " does not join both sides" << std::endl;
+                        side.clear();
+                        return false;
+                }
+        }
+        return true;
+}
@@ -0,0 +1,29 @@
+/******************************************************************************
+ * bipartition.h
+ *
+ * Sides of a bipartite dynamic graph. A sequence is treated as bipartite if
+ * the union of all inserted edges is, then one 2-coloring fits every
+ * intermediate graph.
+ *
+ *****************************************************************************/
+
+#ifndef BIPARTITION_H
+#define BIPARTITION_H
+
+#include <string>
+#include <vector>
+
+#include "definitions.h"
+
+class bipartition {
+        public:
+                // 2-colors the union of all inserted edges, side[v] is 0 or 1.
+                // returns false and clears side if that graph has an odd cycle
+                static bool detect(NodeID n, const std::vector<std::pair<int, std::pair<NodeID, NodeID> > > & edge_sequence, std::vector< NodeID > & side);
+
+                // reads the side (0 or 1) of every node, one per line, and checks that
+                // every inserted edge joins both sides. returns false on errors
+                static bool read(const std::string & filename, NodeID n, const std::vector<std::pair<int, std::pair<NodeID, NodeID> > > & edge_sequence, std::vector< NodeID > & side);
+};
+
+#endif
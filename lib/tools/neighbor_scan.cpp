@@ -0,0 +1,100 @@
+/******************************************************************************
+ * neighbor_scan.cpp
+ *
+ *****************************************************************************/
+
+#include "neighbor_scan.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define SCAN_X86
+#include <immintrin.h>
+#endif
+
+// the kernels read the targets of an edge list as a plain array of NodeIDs
+static_assert(sizeof(DynEdge) == sizeof(NodeID), "DynEdge is not a bare target");
+
+#ifdef SCAN_X86
+__attribute__((target("avx2")))
+static size_t first_free_avx2( const DynEdge * edges, size_t count, const NodeID * matching, NodeID avoid ) {
+        const __m256i nomate   = _mm256_set1_epi32((int) NOMATE);
+        const __m256i excluded = _mm256_set1_epi32((int) avoid);
+
+        size_t i = 0;
+        for( ; i + 8 <= count; i += 8) {
+                __m256i targets = _mm256_loadu_si256((const __m256i *) (edges + i));
+                __m256i mates   = _mm256_i32gather_epi32((const int *) matching, targets, 4);
+                __m256i free    = _mm256_andnot_si256(_mm256_cmpeq_epi32(targets, excluded),
+                                                      _mm256_cmpeq_epi32(mates, nomate));
+                int mask = _mm256_movemask_ps(_mm256_castsi256_ps(free));
+                if( mask != 0 ) return i + __builtin_ctz(mask);
+        }
+        return i + neighbor_scan::first_free_scalar(edges + i, count - i, matching, avoid);
+}
+
+__attribute__((target("avx512f")))
+static size_t first_free_avx512( const DynEdge * edges, size_t count, const NodeID * matching, NodeID avoid ) {
+        const __m512i nomate   = _mm512_set1_epi32((int) NOMATE);
+        const __m512i excluded = _mm512_set1_epi32((int) avoid);
+
+        size_t i = 0;
+        for( ; i + 16 <= count; i += 16) {
+                __m512i targets = _mm512_loadu_si512((const void *) (edges + i));
+                __m512i mates   = _mm512_i32gather_epi32(targets, (const void *) matching, 4);
+                __mmask16 mask  = _mm512_mask_cmpneq_epi32_mask(_mm512_cmpeq_epi32_mask(mates, nomate), targets, excluded);
+                if( mask != 0 ) return i + __builtin_ctz((unsigned) mask);
+        }
+        return i + neighbor_scan::first_free_scalar(edges + i, count - i, matching, avoid);
+}
+#endif
+
+neighbor_scan::scan_kernel neighbor_scan::m_kernel = neighbor_scan::first_free_scalar;
+ScanKernelType             neighbor_scan::m_type   = SCAN_SCALAR;
+
+bool neighbor_scan::supported( ScanKernelType type ) {
+        switch( type ) {
+                case SCAN_SCALAR:
+                        return true;
+#ifdef SCAN_X86
+                case SCAN_AVX2:
+                        __builtin_cpu_init();
+                        return __builtin_cpu_supports("avx2");
+                case SCAN_AVX512:
+                        __builtin_cpu_init();
+                        return __builtin_cpu_supports("avx512f");
+#endif
+                default:
+                        return false;
+        }
+}
+
+void neighbor_scan::set_kernel( ScanKernelType type ) {
+        if( !supported(type) ) return;
+
+        m_type = type;
+        switch( type ) {
+#ifdef SCAN_X86
+                case SCAN_AVX2:
+                        m_kernel = first_free_avx2;
+                        break;
+                case SCAN_AVX512:
+                        m_kernel = first_free_avx512;
+                        break;
+#endif
+                default:
+                        m_kernel = first_free_scalar;
+                        break;
+        }
+}
+
+// the widest kernel the cpu supports
+static struct select_scan_kernel {
+        select_scan_kernel() {
+                const ScanKernelType preference[] = {SCAN_AVX512, SCAN_AVX2};
+                for( ScanKernelType type : preference ) {
+                        if( neighbor_scan::supported(type) ) {
+                                neighbor_scan::set_kernel(type);
+                                return;
+                        }
+                }
+        }
+} select_scan_kernel_at_startup;
@@ -0,0 +1,62 @@
+/******************************************************************************
+ * neighbor_scan.h
+ *
+ * The scan that all algorithms do to settle a node: the first neighbor whose
+ * mate is NOMATE. On x86 the mates of 8 (AVX2) or 16 (AVX-512) neighbors are
+ * gathered and compared at once, the kernel is picked at startup from what
+ * the cpu supports. Short lists are scanned inline.
+ *
+ *****************************************************************************/
+
+#ifndef NEIGHBOR_SCAN_H
+#define NEIGHBOR_SCAN_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+#include "definitions.h"
+
+enum ScanKernelType {
+        SCAN_SCALAR,
+        SCAN_AVX2,
+        SCAN_AVX512
+};
+
+class neighbor_scan {
+        public:
+                // index of the first edge whose target is free and not avoid, count
+                // if there is none. pass NOMATE to avoid nothing
+                static inline size_t first_free( const DynEdge * edges, size_t count,
+                                                 const std::vector< NodeID > & matching, NodeID avoid ) {
+                        // the gathers take signed 32 bit indices
+                        if( count < SHORT || matching.size() > (size_t) INT32_MAX ) {
+                                return first_free_scalar(edges, count, matching.data(), avoid);
+                        }
+                        return m_kernel(edges, count, matching.data(), avoid);
+                }
+
+                static size_t first_free_scalar( const DynEdge * edges, size_t count, const NodeID * matching, NodeID avoid ) {
+                        for( size_t i = 0; i < count; i++) {
+                                NodeID v = edges[i].target;
+                                if( matching[v] == NOMATE && v != avoid ) return i;
+                        }
+                        return count;
+                }
+
+                static bool supported( ScanKernelType type );
+
+                // the kernel is chosen at startup, benchmarks switch it by hand
+                static ScanKernelType get_kernel() { return m_type; }
+                static void set_kernel( ScanKernelType type );
+
+        private:
+                static const size_t SHORT = 16;
+
+                typedef size_t (*scan_kernel)( const DynEdge *, size_t, const NodeID *, NodeID );
+
+                static scan_kernel    m_kernel;
+                static ScanKernelType m_type;
+};
+
+#endif
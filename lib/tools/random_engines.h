@@ -0,0 +1,139 @@
+/******************************************************************************
+ * random_engines.h
+ *
+ * Small, fast pseudo random engines behind random_functions. All of them are
+ * fully determined by their seed, so a run is reproducible for a given engine
+ * and --seed.
+ *
+ *****************************************************************************/
+
+#ifndef RANDOM_ENGINES_H
+#define RANDOM_ENGINES_H
+
+#include <stdint.h>
+
+// Steele, Lea, Flood: one 64 bit word of state, also used to seed xoshiro
+struct splitmix64 {
+        uint64_t s;
+
+        void seed(uint64_t seed) {
+                s = seed;
+        }
+
+        inline uint64_t operator()() {
+                uint64_t z = (s += 0x9e3779b97f4a7c15ULL);
+                z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+                z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+                return z ^ (z >> 31);
+        }
+};
+
+// Blackman, Vigna
+struct xoshiro256ss {
+        uint64_t s[4];
+
+        void seed(uint64_t seed) {
+                splitmix64 sm; sm.seed(seed);
+                for( int i = 0; i < 4; i++) {
+                        s[i] = sm();
+                }
+        }
+
+        static inline uint64_t rotl(uint64_t x, int k) {
+                return (x << k) | (x >> (64 - k));
+        }
+
+        inline uint64_t operator()() {
+                const uint64_t result = rotl(s[1] * 5, 7) * 9;
+                const uint64_t t      = s[1] << 17;
+
+                s[2] ^= s[0];
+                s[3] ^= s[1];
+                s[1] ^= s[2];
+                s[0] ^= s[3];
+                s[2] ^= t;
+                s[3]  = rotl(s[3], 45);
+
+                return result;
+        }
+};
+
+// O'Neill, PCG-XSH-RR with 64 bit state and 32 bit output
+struct pcg32 {
+        uint64_t state;
+        uint64_t inc;
+
+        void seed(uint64_t seed) {
+                state = 0;
+                inc   = (0xda3e39cb94b95bdbULL << 1) | 1;
+                (*this)();
+                state += seed;
+                (*this)();
+        }
+
+        inline uint32_t operator()() {
+                uint64_t old_state = state;
+                state = old_state * 6364136223846793005ULL + inc;
+                uint32_t xorshifted = (uint32_t) (((old_state >> 18) ^ old_state) >> 27);
+                uint32_t rot        = (uint32_t) (old_state >> 59);
+                return (xorshifted >> rot) | (xorshifted << ((-rot) & 31));
+        }
+};
+
+// Salmon et al., Philox4x32-10. Counter based: block i of the stream is a
+// function of (key, i) only, so streams with different keys are independent
+// and a stream can jump to any block in O(1)
+struct philox4x32 {
+        uint32_t key[2];
+        uint32_t ctr[4];   // ctr[0..1] block index, ctr[2..3] stream id
+        uint32_t out[4];
+        uint32_t idx;      // next unused word of out, 4 if none is left
+
+        void seed(uint64_t seed, uint32_t id = 0, uint32_t id_high = 0) {
+                key[0] = (uint32_t) seed;
+                key[1] = (uint32_t) (seed >> 32);
+                ctr[2] = id;
+                ctr[3] = id_high;
+                seek(0);
+        }
+
+        // continue with block i
+        void seek(uint64_t block) {
+                ctr[0] = (uint32_t) block;
+                ctr[1] = (uint32_t) (block >> 32);
+                idx    = 4;
+        }
+
+        inline uint32_t operator()() {
+                if( idx == 4 ) generate();
+                return out[idx++];
+        }
+
+        private:
+                static inline void mulhilo(uint32_t a, uint32_t b, uint32_t & hi, uint32_t & lo) {
+                        uint64_t p = (uint64_t) a * b;
+                        hi = (uint32_t) (p >> 32);
+                        lo = (uint32_t) p;
+                }
+
+                void generate() {
+                        uint32_t c0 = ctr[0], c1 = ctr[1], c2 = ctr[2], c3 = ctr[3];
+                        uint32_t k0 = key[0], k1 = key[1];
+                        for( int round = 0; round < 10; round++) {
+                                uint32_t hi0, lo0, hi1, lo1;
+                                mulhilo(0xD2511F53u, c0, hi0, lo0);
+                                mulhilo(0xCD9E8D57u, c2, hi1, lo1);
+                                c0 = hi1 ^ c1 ^ k0;
+                                c1 = lo1;
+                                c2 = hi0 ^ c3 ^ k1;
+                                c3 = lo0;
+                                k0 += 0x9E3779B9u;
+                                k1 += 0xBB67AE85u;
+                        }
+                        out[0] = c0; out[1] = c1; out[2] = c2; out[3] = c3;
+                        idx = 0;
+                        if( ++ctr[0] == 0 ) ++ctr[1];
+                }
+};
+
+#endif
@@ -3,10 +3,29 @@
  *
  *****************************************************************************/
 
+#include <atomic>
+#include <thread>
+
 #include "random_functions.h"
 
-MersenneTwister random_functions::m_mt;
-std::mt19937_64 random_functions::mt64;
+static const std::thread::id main_thread = std::this_thread::get_id();
+
+// the main thread shares m_default with setSeed callers, every other thread
+// gets a private stream so unscoped draws of worker threads do not race. Their
+// ids follow the order in which threads first draw, reproducible runs hand
+// out streams with split() instead
+random_functions::stream * random_functions::thread_default() {
+        if( std::this_thread::get_id() == main_thread ) return &m_default;
+
+        static std::atomic< uint32_t > next_id(1u << 31);
+        thread_local stream local;
+        local.engine = m_default.engine;
+        local.seed(m_seed, next_id++);
+        return &local;
+}
+
+random_functions::stream random_functions::m_default;
+__thread random_functions::stream * random_functions::m_active = NULL;
 int random_functions::m_seed = 0;
 /*
 random_functions::random_functions()  {
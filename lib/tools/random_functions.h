@@ -8,15 +8,152 @@
 
 #include <iostream>
 #include <random>
+#include <sstream>
 #include <vector>
 
 #include "definitions.h"
 #include "match_config.h"
+#include "random_engines.h"
 
 typedef std::mt19937 MersenneTwister;
 
 class random_functions {
         public:
+                // The engines behind all calls below. The main thread draws from a
+                // process wide default stream, every other thread from its own one;
+                // a stream_scope redirects the calls of the current thread to another
+                // stream, e.g. one owned by an embedded matcher or one of the streams
+                // handed out by split().
+                // Which engine a stream draws from is chosen at run time, the
+                // default at build time (cmake -DRNG_ENGINE=...).
+                struct stream {
+                        RandomEngineType engine;
+                        xoshiro256ss     xoshiro;
+                        pcg32            pcg;
+                        splitmix64       splitmix;
+                        MersenneTwister  m_mt;
+                        philox4x32       philox;
+
+                        stream() : engine(DEFAULT_RNG_ENGINE) {
+                                seed(0);
+                        }
+
+                        // stream id of the sequence (seed, id). Philox keys its
+                        // counter with both, the other engines are seeded with
+                        // a combination of them; id 0 is the plain seed
+                        void seed(int seed, uint32_t id = 0) {
+                                uint64_t combined = id == 0 ? (uint64_t) (int64_t) seed
+                                                            : ((uint64_t) id << 32) | (uint32_t) seed;
+                                xoshiro.seed(combined);
+                                pcg.seed(combined);
+                                splitmix.seed(combined);
+                                if( id == 0 ) {
+                                        m_mt.seed(seed);
+                                } else {
+                                        std::seed_seq sequence{(uint32_t) seed, id};
+                                        m_mt.seed(sequence);
+                                }
+                                philox.seed((uint32_t) seed, id);
+                        }
+
+                        // the engine of the build (-DRNG_ENGINE) is tested first and
+                        // inlined, only streams switched with --rng pay for the switch
+                        inline uint32_t next32() {
+                                if( engine == DEFAULT_RNG_ENGINE ) return draw32< DEFAULT_RNG_ENGINE >();
+                                switch( engine ) {
+                                        case RNG_PCG32:      return draw32< RNG_PCG32 >();
+                                        case RNG_SPLITMIX64: return draw32< RNG_SPLITMIX64 >();
+                                        case RNG_MT19937:    return draw32< RNG_MT19937 >();
+                                        case RNG_PHILOX4X32: return draw32< RNG_PHILOX4X32 >();
+                                        default:             return draw32< RNG_XOSHIRO256SS >();
+                                }
+                        }
+
+                        inline uint64_t next64() {
+                                if( engine == DEFAULT_RNG_ENGINE ) return draw64< DEFAULT_RNG_ENGINE >();
+                                switch( engine ) {
+                                        case RNG_PCG32:      return draw64< RNG_PCG32 >();
+                                        case RNG_SPLITMIX64: return draw64< RNG_SPLITMIX64 >();
+                                        case RNG_MT19937:    return draw64< RNG_MT19937 >();
+                                        case RNG_PHILOX4X32: return draw64< RNG_PHILOX4X32 >();
+                                        default:             return draw64< RNG_XOSHIRO256SS >();
+                                }
+                        }
+
+                        template< RandomEngineType type >
+                        inline uint32_t draw32() {
+                                switch( type ) {
+                                        case RNG_PCG32:      return pcg();
+                                        case RNG_SPLITMIX64: return splitmix() >> 32;
+                                        case RNG_MT19937:    return m_mt();
+                                        case RNG_PHILOX4X32: return philox();
+                                        default:             return xoshiro() >> 32;
+                                }
+                        }
+
+                        template< RandomEngineType type >
+                        inline uint64_t draw64() {
+                                switch( type ) {
+                                        case RNG_PCG32:      return ((uint64_t) pcg() << 32) | pcg();
+                                        case RNG_SPLITMIX64: return splitmix();
+                                        case RNG_MT19937:    return ((uint64_t) m_mt() << 32) | m_mt();
+                                        case RNG_PHILOX4X32: return ((uint64_t) philox() << 32) | philox();
+                                        default:             return xoshiro();
+                                }
+                        }
+
+                        // uniform in [0, range), range 0 stands for 2^32. Lemire's
+                        // multiply-shift, the division is only needed when the low
+                        // word falls into the biased part
+                        inline uint32_t bounded(uint32_t range) {
+                                if( range == 0 ) return next32();
+
+                                uint64_t m = (uint64_t) next32() * range;
+                                uint32_t l = (uint32_t) m;
+                                if( l < range ) {
+                                        uint32_t threshold = -range % range;
+                                        while( l < threshold ) {
+                                                m = (uint64_t) next32() * range;
+                                                l = (uint32_t) m;
+                                        }
+                                }
+                                return m >> 32;
+                        }
+
+                        // textual engine state, used by checkpoints
+                        std::string state() const {
+                                std::stringstream ss;
+                                ss << engine << " " << xoshiro.s[0] << " " << xoshiro.s[1] << " " << xoshiro.s[2] << " " << xoshiro.s[3] << " "
+                                   << pcg.state << " " << pcg.inc << " " << splitmix.s << " " << m_mt;
+                                ss << " " << philox.key[0] << " " << philox.key[1] << " " << philox.idx;
+                                for( int i = 0; i < 4; i++) ss << " " << philox.ctr[i] << " " << philox.out[i];
+                                return ss.str();
+                        }
+
+                        void set_state(const std::string & state) {
+                                std::stringstream ss(state);
+                                int type = DEFAULT_RNG_ENGINE;
+                                ss >> type >> xoshiro.s[0] >> xoshiro.s[1] >> xoshiro.s[2] >> xoshiro.s[3]
+                                   >> pcg.state >> pcg.inc >> splitmix.s >> m_mt;
+                                ss >> philox.key[0] >> philox.key[1] >> philox.idx;
+                                for( int i = 0; i < 4; i++) ss >> philox.ctr[i] >> philox.out[i];
+                                engine = (RandomEngineType) type;
+                        }
+                };
+
+                class stream_scope {
+                        public:
+                                stream_scope(stream & s) : m_previous(&active()) {
+                                        m_active = &s;
+                                }
+
+                                ~stream_scope() {
+                                        m_active = m_previous;
+                                }
+                        private:
+                                stream * m_previous;
+                };
+
                 template<typename sometype>
                         static void permutate_vector_fast(std::vector<sometype> & vec, bool init) {
                                 if(init) {
@@ -28,11 +165,10 @@ class random_functions {
                                 if(vec.size() < 10) return;
 
                                 int distance = 20;
-                                std::uniform_int_distribution<unsigned int> A(0, distance);
                                 unsigned int size = vec.size()-4;
                                 for( unsigned int i = 0; i < size; i++) {
                                         unsigned int posA = i;
-                                        unsigned int posB = (posA + A(m_mt))%size;
+                                        unsigned int posB = (posA + nextInt(0, distance))%size;
                                         std::swap(vec[posA], vec[posB]);
                                         std::swap(vec[posA+1], vec[posB+1]);
                                         std::swap(vec[posA+2], vec[posB+2]);
@@ -53,12 +189,9 @@ class random_functions {
                                         return;
                                 }
                                 unsigned int size = vec.size();
-                                std::uniform_int_distribution<unsigned int> A(0,size - 4);
-                                std::uniform_int_distribution<unsigned int> B(0,size - 4);
-
                                 for( unsigned int i = 0; i < size; i++) {
-                                        unsigned int posA = A(m_mt);
-                                        unsigned int posB = B(m_mt);
+                                        unsigned int posA = nextInt(0, size - 4);
+                                        unsigned int posB = nextInt(0, size - 4);
                                         std::swap(vec[posA], vec[posB]);
                                         std::swap(vec[posA+1], vec[posB+1]);
                                         std::swap(vec[posA+2], vec[posB+2]);
@@ -73,12 +206,9 @@ class random_functions {
                                         return;
                                 }
                                 unsigned int size = vec.size();
-                                std::uniform_int_distribution<unsigned int> A(0,size - 4);
-                                std::uniform_int_distribution<unsigned int> B(0,size - 4);
-
                                 for( unsigned int i = 0; i < size; i++) {
-                                        unsigned int posA = A(m_mt);
-                                        unsigned int posB = B(m_mt);
+                                        unsigned int posA = nextInt(0, size - 4);
+                                        unsigned int posB = nextInt(0, size - 4);
                                         std::swap(vec[posA], vec[posB]);
                                         std::swap(vec[posA+1], vec[posB+1]);
                                         std::swap(vec[posA+2], vec[posB+2]);
@@ -91,12 +221,9 @@ class random_functions {
                         static void permutate_vector_good_small(std::vector<sometype> & vec) {
                                 if(vec.size() < 2) return;
                                 unsigned int size = vec.size();
-                                std::uniform_int_distribution<unsigned int> A(0,size-1);
-                                std::uniform_int_distribution<unsigned int> B(0,size-1);
-
                                 for( unsigned int i = 0; i < size; i++) {
-                                        unsigned int posA = A(m_mt);
-                                        unsigned int posB = B(m_mt);
+                                        unsigned int posA = nextInt(0, size - 1);
+                                        unsigned int posB = nextInt(0, size - 1);
                                         std::swap(vec[posA], vec[posB]);
                                 }
                         }
@@ -125,25 +252,23 @@ class random_functions {
                         }
 
                 static bool nextBool() {
-                        std::uniform_int_distribution<unsigned int> A(0,1);
-                        return (bool) A(m_mt);
+                        return active().next32() >> 31;
                 }
 
 
                 //including lb and rb
                 static unsigned nextInt(unsigned int lb, unsigned int rb) {
-                        std::uniform_int_distribution<unsigned int> A(lb,rb);
-                        return A(m_mt);
+                        return lb + active().bounded(rb - lb + 1);
                 }
 
+                // same as nextInt, kept for the call sites that used a second engine
                 static unsigned nextIntFast(unsigned int lb, unsigned int rb) {
-                        std::uniform_int_distribution<unsigned int> A(lb,rb);
-                        return A(mt64);
+                        return nextInt(lb, rb);
                 }
 
 
                 static double nextDouble(double lb, double rb) {
-                        double rnbr   = (double) rand() / (double) RAND_MAX; // rnd in 0,1
+                        double rnbr   = (active().next64() >> 11) * (1.0 / 9007199254740992.0); // rnd in [0,1)
                         double length = rb - lb;
                         rnbr         *= length;
                         rnbr         += lb;
@@ -151,20 +276,52 @@ class random_functions {
                         return rnbr;
                 }
 
+                // seeds the stream that is active in the calling thread
                 static void setSeed(int seed) {
                         m_seed = seed;
                         srand(seed);
-                        m_mt.seed(m_seed);
+                        active().seed(m_seed);
+                }
+
+                static void setEngine(RandomEngineType engine) {
+                        active().engine = engine;
+                }
+
+                // one stream per thread of a parallel region, thread t uses
+                // streams[t] through a stream_scope. Stream t of region r is the
+                // Philox sequence keyed with the seed of setSeed and the counter
+                // words (t+1, r): it depends on nothing but (seed, t, r), not on
+                // the draws of the calling thread, and the streams of a region
+                // are disjoint by construction. The other engines give no such
+                // guarantee for nearby seeds, so --rng does not apply here
+                static void split(std::vector< stream > & streams, unsigned threads, uint32_t region) {
+                        streams.resize(threads);
+                        for( unsigned t = 0; t < threads; t++) {
+                                streams[t].engine = RNG_PHILOX4X32;
+                                streams[t].philox.seed((uint32_t) m_seed, t+1, region);
+                        }
                 }
 
-                static MersenneTwister getRNG () {
-                        return m_mt;
+                // the stream that is active in the calling thread. hot loops keep
+                // it for their draws instead of looking it up per draw
+                static stream & get_stream () {
+                        return active();
                 }
 
         private:
+                static stream * thread_default();
+
+                static inline stream & active() {
+                        if( m_active == NULL ) m_active = thread_default();
+                        return *m_active;
+                }
+
                 static int m_seed;
-                static MersenneTwister m_mt;
-                static std::mt19937_64 mt64;
+                static stream m_default;
+                // __thread instead of thread_local: a plain pointer needs no
+                // dynamic initialization, so it is read without the tls wrapper
+                // call that thread_local costs outside of its own translation unit
+                static __thread stream * m_active;
 };
 
 #endif /* end of include guard: RANDOM_FUNCTIONS_RMEPKWYT */